@@ -0,0 +1,50 @@
+/**
+ * @file CompactPath.cpp
+ * @brief Encoding and decoding of 2-bit paths
+ * @course ECE 4122/6122 - Homework 1
+ */
+
+#include "CompactPath.h"
+
+bool CompactPath::assign(const std::vector<Position>& path)
+{
+    *this = CompactPath();
+    if (path.empty())
+    {
+        return true;
+    }
+
+    CompactPath encoded(path.front());
+    encoded.reserve(path.size() - 1);
+    for (std::size_t i = 1; i < path.size(); ++i)
+    {
+        int dr = path[i].row - path[i - 1].row;
+        int dc = path[i].col - path[i - 1].col;
+        int direction = -1;
+        for (int d = DIR_NORTH; d <= DIR_WEST; ++d)
+        {
+            if (DIRECTION_ROW[d] == dr && DIRECTION_COL[d] == dc)
+            {
+                direction = d;
+            }
+        }
+        if (direction < 0)
+        {
+            return false; // diagonal or non-adjacent step
+        }
+        encoded.push(direction);
+    }
+    *this = std::move(encoded);
+    return true;
+}
+
+std::vector<Position> CompactPath::decode() const
+{
+    std::vector<Position> path;
+    path.reserve(size());
+    for (const Position& pos : *this)
+    {
+        path.push_back(pos);
+    }
+    return path;
+}
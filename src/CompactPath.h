@@ -0,0 +1,145 @@
+/**
+ * @file CompactPath.h
+ * @brief A 4-connected path stored as 2-bit moves from its start cell
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * std::vector<Position> spends 8 bytes per step. A path through a grid
+ * only ever moves N, E, S or W, so CompactPath keeps the start cell and
+ * packs one CellDirection per step into 2 bits (four moves per byte,
+ * first move in the low bits), about 1/32 of the size. Positions are
+ * decoded lazily by the iterator, one step at a time.
+ *
+ * Paths with diagonal moves (EightConnected) cannot be packed this way;
+ * assign() rejects them.
+ */
+
+#ifndef COMPACT_PATH_H
+#define COMPACT_PATH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+#include "Pathfinder.h" // Position
+
+/**
+ * @class CompactPath
+ * @brief Start cell plus 2 bits per move
+ */
+class CompactPath
+{
+public:
+    /**
+     * @class Iterator
+     * @brief Forward iterator decoding one Position per step
+     */
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Position;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Position*;
+        using reference = const Position&;
+
+        Iterator(const CompactPath* path, std::size_t index, Position position)
+            : m_path(path), m_index(index), m_position(position) {}
+
+        reference operator*() const { return m_position; }
+        pointer operator->() const { return &m_position; }
+
+        Iterator& operator++()
+        {
+            if (m_index < m_path->getMoveCount())
+            {
+                int d = m_path->getMove(m_index);
+                m_position.row += DIRECTION_ROW[d];
+                m_position.col += DIRECTION_COL[d];
+            }
+            ++m_index;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const { return m_index == other.m_index; }
+        bool operator!=(const Iterator& other) const { return m_index != other.m_index; }
+
+    private:
+        const CompactPath* m_path;
+        std::size_t m_index;        // position number, getMoveCount() + 1 at the end
+        Position m_position;
+    };
+
+    /**
+     * @brief Empty path (no cells)
+     */
+    CompactPath() : m_start{-1, -1}, m_moves(0), m_empty(true) {}
+
+    /**
+     * @brief Path consisting of just its start cell; extend with push()
+     */
+    explicit CompactPath(Position start) : m_start(start), m_moves(0), m_empty(false) {}
+
+    /**
+     * @brief Encode a solver result
+     * @return false (and the path is left empty) if two consecutive
+     *         positions are not orthogonal neighbours
+     */
+    bool assign(const std::vector<Position>& path);
+
+    /**
+     * @brief Append one move (DIR_NORTH .. DIR_WEST)
+     */
+    void push(int direction)
+    {
+        if ((m_moves & 3) == 0)
+        {
+            m_bytes.push_back(0);
+        }
+        m_bytes.back() |= static_cast<std::uint8_t>((direction & 3) << ((m_moves & 3) * 2));
+        m_moves++;
+    }
+
+    /**
+     * @brief Reserve room for moves steps
+     */
+    void reserve(std::size_t moves) { m_bytes.reserve((moves + 3) / 4); }
+
+    bool empty() const { return m_empty; }
+    std::size_t size() const { return m_empty ? 0 : m_moves + 1; }     ///< number of positions
+    std::size_t getMoveCount() const { return m_moves; }
+    Position getStart() const { return m_start; }
+    int getMove(std::size_t i) const { return (m_bytes[i >> 2] >> ((i & 3) * 2)) & 3; }
+
+    /**
+     * @brief The packed moves (4 per byte, first move in the low bits)
+     */
+    const std::vector<std::uint8_t>& getBytes() const { return m_bytes; }
+
+    /**
+     * @brief Heap plus inline bytes held by this path
+     */
+    std::size_t getMemoryBytes() const { return sizeof(*this) + m_bytes.capacity(); }
+
+    Iterator begin() const { return Iterator(this, 0, m_start); }
+    Iterator end() const { return Iterator(this, size(), m_start); }
+
+    /**
+     * @brief All positions at once (8 bytes each again)
+     */
+    std::vector<Position> decode() const;
+
+private:
+    Position m_start;
+    std::size_t m_moves;
+    bool m_empty;
+    std::vector<std::uint8_t> m_bytes;
+};
+
+#endif // COMPACT_PATH_H
@@ -0,0 +1,469 @@
+/**
+ * @file HierarchicalPathfinder.cpp
+ * @brief Implementation of HPA* with a cached cluster abstraction
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * A query works as follows:
+ * 1. Recompute any dirty clusters (and their neighbours, whose shared
+ *    borders may have changed).
+ * 2. Local BFS from the start inside its cluster gives edges to that
+ *    cluster's abstract nodes; the same from the goal.
+ * 3. A* over the abstract graph (intra-cluster distances + 1-step border
+ *    crossings) with the Manhattan distance as heuristic.
+ * 4. Each abstract edge on the result is refined into cells with a BFS
+ *    restricted to the one cluster it lies in.
+ */
+
+#include "HierarchicalPathfinder.h"
+#include "PerfCounters.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+
+HierarchicalPathfinder::HierarchicalPathfinder(const Maze& maze, int clusterSize, const std::atomic<bool>* cancel)
+    : m_maze(maze), m_clusterSize(std::max(4, clusterSize)), m_width(0), m_height(0), m_clustersX(0), m_clustersY(0),
+      m_generation(0), m_cancel(cancel)
+{
+    rebuild();
+}
+
+std::size_t HierarchicalPathfinder::clusterOf(int row, int col) const
+{
+    return static_cast<std::size_t>(row / m_clusterSize) * m_clustersX + (col / m_clusterSize);
+}
+
+int HierarchicalPathfinder::localIndex(const Cluster& cluster, std::size_t cell) const
+{
+    int row = static_cast<int>(cell / m_width);
+    int col = static_cast<int>(cell % m_width);
+    return (row - cluster.top) * m_clusterSize + (col - cluster.left);
+}
+
+int HierarchicalPathfinder::getAbstractNodeCount() const
+{
+    int count = 0;
+    for (const Cluster& cluster : m_clusters)
+    {
+        count += static_cast<int>(cluster.nodes.size());
+    }
+    return count;
+}
+
+void HierarchicalPathfinder::rebuild()
+{
+    MAZE_PERF_PHASE("hpaBuild", static_cast<std::uint64_t>(m_maze.getWidth()) * m_maze.getHeight());
+    MAZE_TRACE_ZONE("HierarchicalPathfinder::rebuild");
+
+    m_width = m_maze.getWidth();
+    m_height = m_maze.getHeight();
+    m_generation = m_maze.getGeneration();
+    m_clustersX = (m_width + m_clusterSize - 1) / m_clusterSize;
+    m_clustersY = (m_height + m_clusterSize - 1) / m_clusterSize;
+
+    m_clusters.assign(static_cast<std::size_t>(m_clustersX) * m_clustersY, Cluster());
+    for (int cy = 0; cy < m_clustersY; ++cy)
+    {
+        for (int cx = 0; cx < m_clustersX; ++cx)
+        {
+            Cluster& cluster = m_clusters[static_cast<std::size_t>(cy) * m_clustersX + cx];
+            cluster.top = cy * m_clusterSize;
+            cluster.left = cx * m_clusterSize;
+            cluster.bottom = std::min(m_height, cluster.top + m_clusterSize) - 1;
+            cluster.right = std::min(m_width, cluster.left + m_clusterSize) - 1;
+            cluster.dirty = false;
+        }
+    }
+
+    std::size_t localCells = static_cast<std::size_t>(m_clusterSize) * m_clusterSize;
+    m_localDist.assign(localCells, -1);
+    m_localParent.assign(localCells, -1);
+    m_localQueue.assign(localCells, 0);
+
+    m_dirty.clear();
+    for (std::size_t id = 0; id < m_clusters.size(); ++id)
+    {
+        if (cancelled())
+        {
+            m_generation = 0; // never a maze's generation: the next query starts over
+            return;
+        }
+        buildCluster(id);
+    }
+}
+
+void HierarchicalPathfinder::markCellChanged(int row, int col)
+{
+    if (row < 0 || row >= m_height || col < 0 || col >= m_width)
+    {
+        return;
+    }
+    std::size_t id = clusterOf(row, col);
+    if (!m_clusters[id].dirty)
+    {
+        m_clusters[id].dirty = true;
+        m_dirty.push_back(id);
+    }
+    if (m_generation != 0)
+    {
+        m_generation = m_maze.getGeneration(); // this edit is accounted for
+    }
+}
+
+void HierarchicalPathfinder::refresh()
+{
+    // a regenerated maze, or one edited without markCellChanged, invalidates everything
+    if (m_maze.getGeneration() != m_generation || m_maze.getWidth() != m_width || m_maze.getHeight() != m_height)
+    {
+        rebuild();
+        return;
+    }
+    if (m_dirty.empty())
+    {
+        return;
+    }
+
+    // borders are shared, so neighbours of a dirty cluster need new nodes too
+    std::vector<std::size_t> affected;
+    for (std::size_t id : m_dirty)
+    {
+        int cx = static_cast<int>(id % m_clustersX);
+        int cy = static_cast<int>(id / m_clustersX);
+        affected.push_back(id);
+        if (cx > 0) affected.push_back(id - 1);
+        if (cx + 1 < m_clustersX) affected.push_back(id + 1);
+        if (cy > 0) affected.push_back(id - m_clustersX);
+        if (cy + 1 < m_clustersY) affected.push_back(id + m_clustersX);
+    }
+    std::sort(affected.begin(), affected.end());
+    affected.erase(std::unique(affected.begin(), affected.end()), affected.end());
+
+    for (std::size_t id : affected)
+    {
+        m_clusters[id].dirty = false;
+        buildCluster(id);
+    }
+    m_dirty.clear();
+}
+
+void HierarchicalPathfinder::findEntrances(std::size_t a, std::size_t b, bool east, std::vector<std::size_t>& sideA,
+                                           std::vector<std::size_t>& sideB) const
+{
+    const Cluster& ca = m_clusters[a];
+    const Cluster& cb = m_clusters[b];
+
+    // walk along the shared border; each contiguous open run is one entrance
+    int first = east ? ca.top : ca.left;
+    int last = east ? ca.bottom : ca.right;
+    int runStart = -1;
+    for (int i = first; i <= last + 1; ++i)
+    {
+        bool open = false;
+        if (i <= last)
+        {
+            open = east ? (m_maze.isValidPath(i, ca.right) && m_maze.isValidPath(i, cb.left))
+                        : (m_maze.isValidPath(ca.bottom, i) && m_maze.isValidPath(cb.top, i));
+        }
+        if (open && runStart < 0)
+        {
+            runStart = i;
+        }
+        else if (!open && runStart >= 0)
+        {
+            int mid = (runStart + i - 1) / 2;
+            sideA.push_back(east ? cellIndex(mid, ca.right) : cellIndex(ca.bottom, mid));
+            sideB.push_back(east ? cellIndex(mid, cb.left) : cellIndex(cb.top, mid));
+            runStart = -1;
+        }
+    }
+}
+
+void HierarchicalPathfinder::buildCluster(std::size_t id)
+{
+    Cluster& cluster = m_clusters[id];
+    cluster.nodes.clear();
+
+    int cx = static_cast<int>(id % m_clustersX);
+    int cy = static_cast<int>(id / m_clustersX);
+
+    // collect (own cell, partner cell) pairs from all four borders
+    std::vector<std::size_t> mine, theirs;
+    if (cx > 0) findEntrances(id - 1, id, true, theirs, mine);
+    if (cx + 1 < m_clustersX) findEntrances(id, id + 1, true, mine, theirs);
+    if (cy > 0) findEntrances(id - m_clustersX, id, false, theirs, mine);
+    if (cy + 1 < m_clustersY) findEntrances(id, id + m_clustersX, false, mine, theirs);
+
+    for (std::size_t i = 0; i < mine.size(); ++i)
+    {
+        // a corner cell can be an entrance on two borders: one node, two partners
+        auto it = std::find_if(cluster.nodes.begin(), cluster.nodes.end(),
+                               [&](const AbstractNode& node) { return node.cell == mine[i]; });
+        if (it == cluster.nodes.end())
+        {
+            cluster.nodes.push_back(AbstractNode());
+            cluster.nodes.back().cell = mine[i];
+            it = cluster.nodes.end() - 1;
+        }
+        it->partners.push_back(theirs[i]);
+    }
+
+    // intra-cluster distances between every pair of nodes
+    for (std::size_t i = 0; i < cluster.nodes.size(); ++i)
+    {
+        localBFS(id, cluster.nodes[i].cell, NO_CELL);
+        for (std::size_t j = 0; j < cluster.nodes.size(); ++j)
+        {
+            int dist = m_localDist[localIndex(cluster, cluster.nodes[j].cell)];
+            if (j != i && dist >= 0)
+            {
+                cluster.nodes[i].intra.push_back({static_cast<int>(j), dist});
+            }
+        }
+    }
+}
+
+int HierarchicalPathfinder::localBFS(std::size_t id, std::size_t sourceCell, std::size_t targetCell)
+{
+    const Cluster& cluster = m_clusters[id];
+    int rows = cluster.bottom - cluster.top + 1;
+    int cols = cluster.right - cluster.left + 1;
+    for (int r = 0; r < rows; ++r)
+    {
+        std::fill_n(m_localDist.begin() + r * m_clusterSize, cols, -1);
+    }
+
+    const int dr[] = {-1, 1, 0, 0};
+    const int dc[] = {0, 0, -1, 1};
+
+    int head = 0, tail = 0;
+    int source = localIndex(cluster, sourceCell);
+    m_localDist[source] = 0;
+    m_localParent[source] = -1;
+    m_localQueue[tail++] = source;
+
+    int target = targetCell != NO_CELL ? localIndex(cluster, targetCell) : -1;
+    while (head < tail)
+    {
+        int current = m_localQueue[head++];
+        if (current == target)
+        {
+            break;
+        }
+        int row = cluster.top + current / m_clusterSize;
+        int col = cluster.left + current % m_clusterSize;
+        for (int i = 0; i < 4; ++i)
+        {
+            int nRow = row + dr[i];
+            int nCol = col + dc[i];
+            if (nRow < cluster.top || nRow > cluster.bottom || nCol < cluster.left || nCol > cluster.right)
+            {
+                continue; // stay inside the cluster
+            }
+            int next = (nRow - cluster.top) * m_clusterSize + (nCol - cluster.left);
+            if (m_localDist[next] < 0 && m_maze.isValidPath(nRow, nCol))
+            {
+                m_localDist[next] = m_localDist[current] + 1;
+                m_localParent[next] = current;
+                m_localQueue[tail++] = next;
+            }
+        }
+    }
+    return tail;
+}
+
+void HierarchicalPathfinder::appendLocalPath(const Cluster& cluster, std::size_t targetCell, std::vector<Position>& path) const
+{
+    std::size_t first = path.size();
+    for (int local = localIndex(cluster, targetCell); m_localParent[local] >= 0; local = m_localParent[local])
+    {
+        path.push_back({cluster.top + local / m_clusterSize, cluster.left + local % m_clusterSize});
+    }
+    std::reverse(path.begin() + first, path.end());
+}
+
+std::vector<Position> HierarchicalPathfinder::findPath(Position start, Position goal, int& nodes)
+{
+    MAZE_PERF_PHASE("hpaQuery", static_cast<std::uint64_t>(m_width) * m_height);
+    MAZE_TRACE_ZONE("HierarchicalPathfinder::findPath");
+
+    nodes = 0;
+    refresh();
+    if (cancelled())
+    {
+        return {};
+    }
+
+    if (!m_maze.isValidPath(start.row, start.col) || !m_maze.isValidPath(goal.row, goal.col))
+    {
+        return {};
+    }
+
+    std::size_t startCell = cellIndex(start.row, start.col);
+    std::size_t goalCell = cellIndex(goal.row, goal.col);
+    std::size_t startCluster = clusterOf(start.row, start.col);
+    std::size_t goalCluster = clusterOf(goal.row, goal.col);
+
+    // temporary edges: start -> nodes of its cluster, nodes of goal cluster -> goal
+    std::vector<std::pair<std::size_t, int>> startEdges; // (cell, distance)
+    nodes += localBFS(startCluster, startCell, NO_CELL);
+    for (const AbstractNode& node : m_clusters[startCluster].nodes)
+    {
+        int dist = m_localDist[localIndex(m_clusters[startCluster], node.cell)];
+        if (dist >= 0)
+        {
+            startEdges.push_back({node.cell, dist});
+        }
+    }
+    if (startCluster == goalCluster)
+    {
+        int dist = m_localDist[localIndex(m_clusters[startCluster], goalCell)];
+        if (dist >= 0)
+        {
+            startEdges.push_back({goalCell, dist});
+        }
+    }
+
+    std::unordered_map<std::size_t, int> goalEdges; // node cell -> distance to goal
+    nodes += localBFS(goalCluster, goalCell, NO_CELL);
+    for (const AbstractNode& node : m_clusters[goalCluster].nodes)
+    {
+        int dist = m_localDist[localIndex(m_clusters[goalCluster], node.cell)];
+        if (dist >= 0)
+        {
+            goalEdges[node.cell] = dist;
+        }
+    }
+
+    auto heuristic = [&](std::size_t cell) {
+        return std::abs(static_cast<std::int64_t>(cell / m_width) - goal.row) +
+               std::abs(static_cast<std::int64_t>(cell % m_width) - goal.col);
+    };
+
+    // A* over the abstract graph, keyed by cell index
+    typedef std::pair<std::int64_t, std::size_t> Entry; // (f, cell)
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    std::unordered_map<std::size_t, std::int64_t> cost;
+    std::unordered_map<std::size_t, std::size_t> parent;
+    cost[startCell] = 0;
+    parent[startCell] = NO_CELL;
+    open.push({heuristic(startCell), startCell});
+
+    auto relax = [&](std::size_t from, std::size_t to, int weight) {
+        std::int64_t g = cost[from] + weight;
+        auto it = cost.find(to);
+        if (it == cost.end() || g < it->second)
+        {
+            cost[to] = g;
+            parent[to] = from;
+            open.push({g + heuristic(to), to});
+        }
+    };
+
+    bool found = false;
+    while (!open.empty())
+    {
+        if (cancelled())
+        {
+            return {};
+        }
+        Entry top = open.top();
+        open.pop();
+        std::size_t cell = top.second;
+        if (top.first - heuristic(cell) > cost[cell])
+        {
+            continue; // stale entry
+        }
+        nodes++;
+        if (cell == goalCell)
+        {
+            found = true;
+            break;
+        }
+
+        if (cell == startCell)
+        {
+            for (const auto& edge : startEdges)
+            {
+                relax(cell, edge.first, edge.second);
+            }
+        }
+
+        const Cluster& cluster = m_clusters[clusterOf(static_cast<int>(cell / m_width), static_cast<int>(cell % m_width))];
+        for (const AbstractNode& node : cluster.nodes)
+        {
+            if (node.cell != cell)
+            {
+                continue;
+            }
+            for (const auto& edge : node.intra)
+            {
+                relax(cell, cluster.nodes[edge.first].cell, edge.second);
+            }
+            for (std::size_t partner : node.partners)
+            {
+                relax(cell, partner, 1);
+            }
+            break;
+        }
+
+        auto toGoal = goalEdges.find(cell);
+        if (toGoal != goalEdges.end())
+        {
+            relax(cell, goalCell, toGoal->second);
+        }
+    }
+
+    if (!found)
+    {
+        return {};
+    }
+
+    std::vector<std::size_t> route;
+    for (std::size_t cell = goalCell; cell != NO_CELL; cell = parent[cell])
+    {
+        route.push_back(cell);
+    }
+    std::reverse(route.begin(), route.end());
+
+    // refine: border crossings are single steps, everything else stays in one cluster
+    std::vector<Position> path;
+    path.push_back(start);
+    for (std::size_t i = 1; i < route.size(); ++i)
+    {
+        std::size_t from = route[i - 1];
+        std::size_t to = route[i];
+        int fromRow = static_cast<int>(from / m_width), fromCol = static_cast<int>(from % m_width);
+        int toRow = static_cast<int>(to / m_width), toCol = static_cast<int>(to % m_width);
+        if (std::abs(fromRow - toRow) + std::abs(fromCol - toCol) == 1)
+        {
+            path.push_back({toRow, toCol});
+            continue;
+        }
+        std::size_t id = clusterOf(fromRow, fromCol);
+        nodes += localBFS(id, from, to);
+        appendLocalPath(m_clusters[id], to, path);
+    }
+    return path;
+}
+
+std::vector<Position> solveHierarchical(Maze& goalMaze, HierarchicalPathfinder& pathfinder, int& nodes)
+{
+    Position start = {goalMaze.getStart().first, goalMaze.getStart().second};
+    Position end = {goalMaze.getEnd().first, goalMaze.getEnd().second};
+
+    std::vector<Position> path = pathfinder.findPath(start, end, nodes);
+
+    // same Solution marking as reconstructPath
+    for (const Position& pos : path)
+    {
+        CellType type = goalMaze.getCell(pos.row, pos.col).type;
+        if (type != CellType::Start && type != CellType::End)
+        {
+            goalMaze.setCellType(pos.row, pos.col, CellType::Solution);
+        }
+    }
+    return path;
+}
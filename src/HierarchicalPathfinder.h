@@ -0,0 +1,180 @@
+/**
+ * @file HierarchicalPathfinder.h
+ * @brief Hierarchical pathfinding (HPA*) over a cached cluster abstraction
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * The maze is partitioned into square clusters. Wherever a cluster border
+ * can be crossed, an entrance is placed (one per contiguous open run,
+ * at its middle), giving one abstract node on each side. Inside each
+ * cluster the distances between its abstract nodes are precomputed with
+ * a BFS limited to that cluster.
+ *
+ * A query connects start and goal to the nodes of their own clusters,
+ * runs A* over the small abstract graph, and then refines only the
+ * abstract edges on the chosen route back into cells. Query cost grows
+ * with the number of clusters along the path rather than with the number
+ * of cells in the maze.
+ *
+ * Cluster data is cached. After editing cells, call markCellChanged();
+ * the next query recomputes only the dirty clusters and their neighbours.
+ * The abstraction remembers Maze::getGeneration() as of its last build
+ * or markCellChanged(), so a maze that changed behind its back (e.g.
+ * Maze::generate()) is rebuilt on the next query instead of answered
+ * from stale clusters.
+ *
+ * Cell indices are std::size_t (row * width + col), so mazes beyond
+ * 2^31 cells index correctly.
+ */
+
+#ifndef HIERARCHICAL_PATHFINDER_H
+#define HIERARCHICAL_PATHFINDER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <utility>
+#include "MazeGenerator.h"
+#include "Pathfinder.h" // Position
+
+/**
+ * @class HierarchicalPathfinder
+ * @brief Cluster abstraction of one Maze plus HPA* queries against it
+ *
+ * The maze must outlive the pathfinder. Results are exact shortest paths
+ * on perfect mazes (every route is unique); on mazes with loops they are
+ * near-optimal, as usual for HPA*.
+ */
+class HierarchicalPathfinder
+{
+public:
+    /**
+     * @brief Build the abstraction for a maze
+     * @param maze maze to abstract (read through isValidPath)
+     * @param clusterSize edge length of a cluster in cells
+     * @param cancel optional; once true, building and queries stop early,
+     *        findPath returns an empty path and the next query rebuilds
+     */
+    HierarchicalPathfinder(const Maze& maze, int clusterSize = 32, const std::atomic<bool>* cancel = nullptr);
+
+    /**
+     * @brief Recompute every cluster (e.g. after Maze::generate)
+     */
+    void rebuild();
+
+    /**
+     * @brief Record that a cell's wall/path state changed (call after
+     * the edit, for every edited cell)
+     * @param row Row index
+     * @param col Column index
+     */
+    void markCellChanged(int row, int col);
+
+    /**
+     * @brief Recompute dirty clusters now (queries also do this lazily)
+     */
+    void refresh();
+
+    /**
+     * @brief Find a path between two open cells
+     * @param start start cell
+     * @param goal goal cell
+     * @param nodes abstract nodes expanded plus cells touched during refinement
+     * @return path from start to goal inclusive, empty if unreachable
+     */
+    std::vector<Position> findPath(Position start, Position goal, int& nodes);
+
+    int getClusterSize() const { return m_clusterSize; }
+    int getClusterCount() const { return static_cast<int>(m_clusters.size()); }
+    int getAbstractNodeCount() const;
+    int getDirtyClusterCount() const { return static_cast<int>(m_dirty.size()); }
+
+private:
+    static const std::size_t NO_CELL = static_cast<std::size_t>(-1);
+
+    /**
+     * @struct AbstractNode
+     * @brief Entrance cell of a cluster and its abstract edges
+     */
+    struct AbstractNode
+    {
+        std::size_t cell;                           ///< flat cell index (row * width + col)
+        std::vector<std::pair<int, int>> intra;     ///< (node index in same cluster, distance)
+        std::vector<std::size_t> partners;          ///< cells across a cluster border (distance 1)
+    };
+
+    /**
+     * @struct Cluster
+     * @brief Cached abstraction data of one cluster
+     */
+    struct Cluster
+    {
+        int top, left, bottom, right;   ///< cell bounds, inclusive
+        std::vector<AbstractNode> nodes;
+        bool dirty;
+    };
+
+    const Maze& m_maze;
+    int m_clusterSize;
+    int m_width, m_height;          // maze size the clusters were built for
+    int m_clustersX, m_clustersY;
+    std::vector<Cluster> m_clusters;
+    std::vector<std::size_t> m_dirty;   // cluster ids awaiting recompute
+    std::uint64_t m_generation;         // Maze::getGeneration() the clusters describe, 0 = incomplete
+    const std::atomic<bool>* m_cancel;
+
+    // scratch buffers for cluster-local BFS, sized clusterSize^2
+    std::vector<int> m_localDist;
+    std::vector<int> m_localParent;
+    std::vector<int> m_localQueue;
+
+    bool cancelled() const { return m_cancel && m_cancel->load(std::memory_order_relaxed); }
+    std::size_t clusterOf(int row, int col) const;
+    std::size_t cellIndex(int row, int col) const { return static_cast<std::size_t>(row) * m_width + col; }
+
+    /**
+     * @brief Append the entrances on the border between two adjacent clusters
+     * @param a first cluster id
+     * @param b cluster id east or south of a
+     * @param east true if b is east of a, false if south
+     * @param sideA entrance cells on a's side
+     * @param sideB matching entrance cells on b's side
+     */
+    void findEntrances(std::size_t a, std::size_t b, bool east, std::vector<std::size_t>& sideA,
+                       std::vector<std::size_t>& sideB) const;
+
+    /**
+     * @brief Recompute the nodes and intra-cluster distances of one cluster
+     */
+    void buildCluster(std::size_t id);
+
+    /**
+     * @brief BFS restricted to one cluster from a source cell
+     * @param targetCell stop once reached, NO_CELL to search the whole cluster
+     * @return number of cells reached; distances in m_localDist
+     */
+    int localBFS(std::size_t id, std::size_t sourceCell, std::size_t targetCell);
+
+    /**
+     * @brief Local (in-cluster) index of a cell, used for scratch buffers
+     */
+    int localIndex(const Cluster& cluster, std::size_t cell) const;
+
+    /**
+     * @brief Append the path found by the last localBFS, excluding its
+     * source cell and including targetCell
+     */
+    void appendLocalPath(const Cluster& cluster, std::size_t targetCell, std::vector<Position>& path) const;
+};
+
+/**
+ * @brief Solve the maze from start to end with HPA* and mark the Solution
+ * cells like reconstructPath does.
+ * @param goalMaze maze to solve
+ * @param pathfinder abstraction built for goalMaze
+ * @param nodes abstract nodes expanded plus refined cells
+ * @return path from start to end inclusive, empty if none
+ */
+std::vector<Position> solveHierarchical(Maze& goalMaze, HierarchicalPathfinder& pathfinder, int& nodes);
+
+#endif // HIERARCHICAL_PATHFINDER_H
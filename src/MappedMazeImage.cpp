@@ -0,0 +1,133 @@
+/**
+ * @file MappedMazeImage.cpp
+ * @brief Implementation of the memory-mapped PPM maze view
+ * @course ECE 4122/6122 - Homework 1
+ */
+
+#include "MappedMazeImage.h"
+#include "MazeRasterizer.h" // CELL_PALETTE
+#include <cctype>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAZE_HAVE_MMAP 1
+#endif
+
+namespace
+{
+    /**
+     * Read one unsigned decimal header field, skipping whitespace and
+     * '#' comments. Returns -1 on malformed input.
+     */
+    long long readHeaderNumber(const std::uint8_t* data, std::size_t size, std::size_t& pos)
+    {
+        while (pos < size)
+        {
+            if (data[pos] == '#')
+            {
+                while (pos < size && data[pos] != '\n')
+                {
+                    ++pos;
+                }
+            }
+            else if (std::isspace(data[pos]))
+            {
+                ++pos;
+            }
+            else
+            {
+                break;
+            }
+        }
+        long long value = -1;
+        while (pos < size && std::isdigit(data[pos]))
+        {
+            value = (value < 0 ? 0 : value * 10) + (data[pos] - '0');
+            if (value > (1LL << 31))
+            {
+                return -1;
+            }
+            ++pos;
+        }
+        return value;
+    }
+}
+
+MappedMazeImage::~MappedMazeImage()
+{
+    close();
+}
+
+bool MappedMazeImage::open(const std::string& path)
+{
+    close();
+#ifdef MAZE_HAVE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < 8)
+    {
+        ::close(fd);
+        return false;
+    }
+    std::size_t size = static_cast<std::size_t>(info.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // the mapping keeps the file referenced
+    if (mapping == MAP_FAILED)
+    {
+        return false;
+    }
+    m_data = static_cast<const std::uint8_t*>(mapping);
+    m_size = size;
+
+    // "P6 <width> <height> 255" followed by exactly one whitespace byte
+    std::size_t pos = 2;
+    long long width = readHeaderNumber(m_data, m_size, pos);
+    long long height = readHeaderNumber(m_data, m_size, pos);
+    long long maxValue = readHeaderNumber(m_data, m_size, pos);
+    pos++;
+    if (m_data[0] != 'P' || m_data[1] != '6' || width < 3 || height < 3 || maxValue != 255 ||
+        pos + static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 3 > m_size)
+    {
+        close();
+        return false;
+    }
+    m_width = static_cast<int>(width);
+    m_height = static_cast<int>(height);
+    m_pixels = pos;
+    return true;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+void MappedMazeImage::close()
+{
+#ifdef MAZE_HAVE_MMAP
+    if (m_data != nullptr)
+    {
+        munmap(const_cast<std::uint8_t*>(m_data), m_size);
+    }
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_width = m_height = 0;
+}
+
+bool MappedMazeImage::isValidPath(int row, int col) const
+{
+    if (!isInBounds(row, col))
+    {
+        return false;
+    }
+    const std::uint8_t* pixel = m_data + m_pixels + (static_cast<std::size_t>(row) * m_width + col) * 3;
+    const RGB& wall = CELL_PALETTE[static_cast<int>(CellType::Wall)];
+    return pixel[0] != wall.r || pixel[1] != wall.g || pixel[2] != wall.b;
+}
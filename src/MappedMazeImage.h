@@ -0,0 +1,81 @@
+/**
+ * @file MappedMazeImage.h
+ * @brief Read-only maze view over a memory-mapped PPM exported by MazeExport
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * A maze exported at --scale 1 as binary PPM stores one pixel per cell,
+ * so the file itself can serve as the maze: the image is mapped, never
+ * loaded, and the kernel pages in only the parts a solver touches. Any
+ * pixel that is not the wall color counts as open (overlay colors from a
+ * --solve export included).
+ *
+ * The view offers the subset of the Maze interface the streaming solvers
+ * use (StreamingSolvers.h). Start and end follow Maze's placement: (1, 1)
+ * and (height - 2, width - 2).
+ */
+
+#ifndef MAPPED_MAZE_IMAGE_H
+#define MAPPED_MAZE_IMAGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+/**
+ * @class MappedMazeImage
+ * @brief Maze grid backed by a memory-mapped P6 image
+ */
+class MappedMazeImage
+{
+public:
+    MappedMazeImage() = default;
+    ~MappedMazeImage();
+
+    MappedMazeImage(const MappedMazeImage&) = delete;
+    MappedMazeImage& operator=(const MappedMazeImage&) = delete;
+
+    /**
+     * @brief Map an image file
+     * @param path binary PPM written by MazeExport with --scale 1
+     * @return false if the file cannot be mapped or is not such an image
+     *         (memory mapping is only available on POSIX systems)
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Unmap the image (also done by the destructor)
+     */
+    void close();
+
+    bool isOpen() const { return m_data != nullptr; }
+
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+    std::pair<int, int> getStart() const { return {1, 1}; }
+    std::pair<int, int> getEnd() const { return {m_height - 2, m_width - 2}; }
+
+    /**
+     * @brief Size of the mapping in bytes
+     */
+    std::size_t getMappedBytes() const { return m_size; }
+
+    bool isInBounds(int row, int col) const
+    {
+        return row >= 0 && row < m_height && col >= 0 && col < m_width;
+    }
+
+    /**
+     * @brief Check if a cell is in bounds and not a wall pixel
+     */
+    bool isValidPath(int row, int col) const;
+
+private:
+    const std::uint8_t* m_data = nullptr;   // whole mapping
+    std::size_t m_size = 0;
+    std::size_t m_pixels = 0;               // offset of the first pixel
+    int m_width = 0;
+    int m_height = 0;
+};
+
+#endif // MAPPED_MAZE_IMAGE_H
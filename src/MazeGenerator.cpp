@@ -3,7 +3,7 @@
  * @brief Implementation of maze generation using recursive backtracking
  * @course ECE 4122/6122 - Homework 21
  * 
- * The recursive backtracking algorithm works as follows:
+ * The backtracking algorithm works as follows:
  * 1. Start with a grid full of walls
  * 2. Pick a starting cell and mark it as visited
  * 3. While there are unvisited cells:
@@ -15,13 +15,71 @@
  *    b. Else if stack is not empty:
  *       - Pop a cell from stack and make it current
  * 4. Algorithm terminates when stack is empty
+ *
+ * The row-parallel generators (Binary Tree, Sidewinder) work as follows:
+ * 1. Draw one base seed from the maze RNG; row i gets its own stream
+ *    seeded from (base seed, i), so the result does not depend on how
+ *    rows are split across threads.
+ * 2. Each thread carves a contiguous block of rows, 64 random decisions
+ *    per 64-bit draw:
+ *    - Binary Tree: each cell opens north or west (top row: west only).
+ *    - Sidewinder: each cell either extends the current run east or
+ *      closes it, opening north from one random cell of the run
+ *      (top row: one long run).
  */
 
 #include "MazeGenerator.h"
+#include "PerfCounters.h"
+#include "Trace.h"
 #include <algorithm>
 #include <chrono>
+#include <thread>
 
-Maze::Maze(int width, int height) 
+namespace
+{
+    // splitmix64: tiny, fast, and good enough to drive per-row decisions
+    std::uint64_t splitmix64(std::uint64_t& state)
+    {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // source of Maze::getGeneration() values, shared by all mazes
+    std::atomic<std::uint64_t> generationCounter(0);
+
+    std::uint64_t nextGeneration()
+    {
+        return generationCounter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+}
+
+const char* generatorName(GeneratorAlgorithm algorithm)
+{
+    switch (algorithm)
+    {
+        case GeneratorAlgorithm::BinaryTree: return "binarytree";
+        case GeneratorAlgorithm::Sidewinder: return "sidewinder";
+        default: return "backtracker";
+    }
+}
+
+bool parseGeneratorAlgorithm(const std::string& name, GeneratorAlgorithm& algorithm)
+{
+    const GeneratorAlgorithm all[] = {GeneratorAlgorithm::Backtracker, GeneratorAlgorithm::BinaryTree, GeneratorAlgorithm::Sidewinder};
+    for (GeneratorAlgorithm candidate : all)
+    {
+        if (name == generatorName(candidate))
+        {
+            algorithm = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+Maze::Maze(int width, int height, int maxDimension) 
 {
     // Ensure dimensions are odd for proper maze structure
     // (walls on even indices, paths on odd indices)
@@ -29,146 +87,410 @@ Maze::Maze(int width, int height)
     m_height = (height % 2 == 0) ? height + 1 : height;
     
     // Enforce minimum and maximum sizes
-    m_width = std::max(11, std::min(m_width, 101));
-    m_height = std::max(11, std::min(m_height, 101));
+    // (keep the upper bound odd so clamping preserves the wall structure)
+    int maxSize = (maxDimension % 2 == 0) ? maxDimension + 1 : maxDimension;
+    m_width = std::max(11, std::min(m_width, maxSize));
+    m_height = std::max(11, std::min(m_height, maxSize));
+    m_tilesX = (m_width + TILE_SIZE - 1) / TILE_SIZE;
+    
+    for (int d = 0; d < 8; ++d)
+    {
+        m_rowMajorStep[d] = static_cast<std::ptrdiff_t>(DIRECTION_ROW[d]) * m_width + DIRECTION_COL[d];
+    }
     
     // Seed random number generator
     auto seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
     m_rng.seed(static_cast<unsigned int>(seed));
     
+    m_generation = nextGeneration();
     initializeGrid();
 }
 
 void Maze::initializeGrid() 
 {
-    m_grid.resize(m_height);
-    for (int row = 0; row < m_height; ++row) {
-        m_grid[row].resize(m_width);
-        for (int col = 0; col < m_width; ++col) {
-            m_grid[row][col].type = CellType::Wall;
-            m_grid[row][col].visited = false;
-            m_grid[row][col].row = row;
-            m_grid[row][col].col = col;
+    // one flat allocation; assign() resets every cell to a fresh wall
+    m_grid.assign(slotsIn(m_layout), Cell());
+}
+
+std::size_t Maze::slotsIn(CellLayout layout) const
+{
+    if (layout == CellLayout::RowMajor)
+    {
+        return static_cast<std::size_t>(m_width) * m_height;
+    }
+    std::size_t tilesY = static_cast<std::size_t>(m_height + TILE_SIZE - 1) / TILE_SIZE;
+    return tilesY * m_tilesX * TILE_SIZE * TILE_SIZE;
+}
+
+void Maze::setLayout(CellLayout layout)
+{
+    if (layout == m_layout)
+    {
+        return;
+    }
+    MAZE_TRACE_ZONE("Maze::setLayout");
+
+    // padding slots of a tiled grid stay walls
+    std::vector<Cell> grid(slotsIn(layout));
+    for (int row = 0; row < m_height; ++row)
+    {
+        for (int col = 0; col < m_width; ++col)
+        {
+            grid[indexIn(layout, row, col)] = m_grid[index(row, col)];
         }
     }
+    m_grid.swap(grid);
+    m_layout = layout;
 }
 
 void Maze::generate() 
 {
+    MAZE_PERF_PHASE("generate", static_cast<std::uint64_t>(m_width) * m_height);
+    MAZE_TRACE_ZONE("Maze::generate");
+    m_generation = nextGeneration();
+
+    if (m_algorithm != GeneratorAlgorithm::Backtracker)
+    {
+        // row-parallel generators write every cell, no reset pass needed
+        carveRows(nullptr, nullptr);
+        placeStartAndEnd();
+        return;
+    }
+
     // Reset the grid
     initializeGrid();
     
     // Start carving from position (1,1)
     // We use odd coordinates for paths, even for walls
-    carvePassages(1, 1);
+    carvePassages(1, 1, nullptr, nullptr);
     
     // Place start and end positions
     placeStartAndEnd();
 }
 
-void Maze::carvePassages(int row, int col) 
+bool Maze::generate(const std::atomic<bool>& cancel, std::atomic<int>& progressPercent) 
+{
+    MAZE_PERF_PHASE("generate", static_cast<std::uint64_t>(m_width) * m_height);
+    MAZE_TRACE_ZONE("Maze::generate (background)");
+    m_generation = nextGeneration();
+
+    progressPercent = 0;
+    if (m_algorithm != GeneratorAlgorithm::Backtracker)
+    {
+        if (!carveRows(&cancel, &progressPercent))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        initializeGrid();
+        if (!carvePassages(1, 1, &cancel, &progressPercent))
+        {
+            return false;
+        }
+    }
+    placeStartAndEnd();
+    progressPercent = 100;
+    return true;
+}
+
+bool Maze::carvePassages(int row, int col, const std::atomic<bool>* cancel, std::atomic<int>* progressPercent) 
 {
-    // Mark current cell as visited and carve it out
-    m_grid[row][col].visited = true;
-    m_grid[row][col].type = CellType::Path;
+    MAZE_TRACE_ZONE("Maze::carvePassages");
+
+    // Explicit stack instead of recursion: a 20000x20000 maze would
+    // otherwise recurse tens of millions of frames deep.
+    std::vector<std::pair<int, int>> cellStack;
+    std::pair<int, int> neighbors[4];
     
-    // Get all unvisited neighbors (2 cells away to maintain wall structure)
-    std::vector<std::pair<int, int>> neighbors = getUnvisitedNeighbors(row, col);
+    // progress = carved cells / cells on odd coordinates
+    const std::uint64_t totalCells = static_cast<std::uint64_t>((m_height - 1) / 2) * ((m_width - 1) / 2);
+    std::uint64_t carvedCells = 1;
+    std::uint64_t steps = 0;
     
-    // Shuffle neighbors for randomness
-    std::shuffle(neighbors.begin(), neighbors.end(), m_rng);
+    // Mark starting cell as visited and carve it out
+    m_grid[index(row, col)].visited = true;
+    m_grid[index(row, col)].type = CellType::Path;
+    cellStack.push_back({row, col});
     
-    // Visit each neighbor
-    for (const auto& neighbor : neighbors) 
+    while (!cellStack.empty()) 
     {
-        int nRow = neighbor.first;
-        int nCol = neighbor.second;
+        // poll the shared flags only every few thousand steps
+        if ((++steps & 4095) == 0)
+        {
+            if (cancel && cancel->load(std::memory_order_relaxed))
+            {
+                return false;
+            }
+            if (progressPercent)
+            {
+                progressPercent->store(static_cast<int>(carvedCells * 100 / totalCells), std::memory_order_relaxed);
+            }
+        }
+
+        int currentRow = cellStack.back().first;
+        int currentCol = cellStack.back().second;
         
-        // Check if still unvisited (may have been visited via different path)
-        if (!m_grid[nRow][nCol].visited) 
+        // Get all unvisited neighbors (2 cells away to maintain wall structure)
+        int count = getUnvisitedNeighbors(currentRow, currentCol, neighbors);
+        if (count == 0) 
         {
-            // Carve through the wall between current and neighbor
-            int wallRow = row + (nRow - row) / 2;
-            int wallCol = col + (nCol - col) / 2;
-            m_grid[wallRow][wallCol].type = CellType::Path;
-            
-            // Recursively carve from neighbor
-            carvePassages(nRow, nCol);
+            // Dead end, backtrack
+            cellStack.pop_back();
+            continue;
         }
+        
+        // Choose random neighbor
+        std::uniform_int_distribution<int> dist(0, count - 1);
+        std::pair<int, int> chosen = neighbors[dist(m_rng)];
+
+        // Carve through the wall between current and chosen cell
+        int wallRow = currentRow + (chosen.first - currentRow) / 2;
+        int wallCol = currentCol + (chosen.second - currentCol) / 2;
+        m_grid[index(wallRow, wallCol)].type = CellType::Path;
+
+        // Move to chosen cell
+        m_grid[index(chosen.first, chosen.second)].visited = true;
+        m_grid[index(chosen.first, chosen.second)].type = CellType::Path;
+        cellStack.push_back(chosen);
+        carvedCells++;
     }
+    return true;
 }
 
-std::vector<std::pair<int, int>> Maze::getUnvisitedNeighbors(int row, int col) 
+bool Maze::carveRows(const std::atomic<bool>* cancel, std::atomic<int>* progressPercent)
 {
-    std::vector<std::pair<int, int>> neighbors;
-    
+    MAZE_TRACE_ZONE("Maze::carveRows");
+
+    // rows are carved through raw row pointers, so carve in row-major
+    // order and convert to the requested layout afterwards
+    const CellLayout layout = m_layout;
+    m_layout = CellLayout::RowMajor;
+
+    // size only: every cell is written below
+    m_grid.resize(static_cast<std::size_t>(m_width) * m_height);
+
+    const int mazeRows = (m_height - 1) / 2;
+    const std::uint64_t baseSeed = (static_cast<std::uint64_t>(m_rng()) << 32) | m_rng();
+
+    // bottom border row is not owned by any maze row
+    std::fill_n(&m_grid[index(m_height - 1, 0)], m_width, Cell());
+
+    unsigned threads = m_generatorThreads != 0 ? m_generatorThreads : std::thread::hardware_concurrency();
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(mazeRows)));
+    MAZE_PERF_WORKERS(threads);
+
+    std::atomic<int> rowsDone(0);
+    std::atomic<bool> cancelled(false);
+    auto worker = [&](int firstRow, int lastRow) {
+        for (int i = firstRow; i < lastRow; ++i)
+        {
+            if (cancel && cancel->load(std::memory_order_relaxed))
+            {
+                cancelled = true;
+                return;
+            }
+            std::uint64_t rowSeed = baseSeed ^ (static_cast<std::uint64_t>(i) * 0xD1B54A32D192ED03ull);
+            if (m_algorithm == GeneratorAlgorithm::BinaryTree)
+            {
+                carveRowBinaryTree(i, rowSeed);
+            }
+            else
+            {
+                carveRowSidewinder(i, rowSeed);
+            }
+            int done = rowsDone.fetch_add(1, std::memory_order_relaxed) + 1;
+            if (progressPercent && (done & 63) == 0)
+            {
+                progressPercent->store(static_cast<int>(static_cast<std::int64_t>(done) * 100 / mazeRows), std::memory_order_relaxed);
+            }
+        }
+    };
+
+    // contiguous blocks of rows per thread
+    std::vector<std::thread> workers;
+    int perThread = (mazeRows + static_cast<int>(threads) - 1) / static_cast<int>(threads);
+    for (int first = perThread; first < mazeRows; first += perThread)
+    {
+        workers.emplace_back(worker, first, std::min(mazeRows, first + perThread));
+    }
+    worker(0, std::min(mazeRows, perThread)); // calling thread takes the first block
+    for (std::thread& thread : workers)
+    {
+        thread.join();
+    }
+    setLayout(layout);
+    return !cancelled;
+}
+
+void Maze::carveRowBinaryTree(int i, std::uint64_t seed)
+{
+    Cell* above = &m_grid[index(2 * i, 0)];     // wall row above (north passages)
+    Cell* row = &m_grid[index(2 * i + 1, 0)];   // cell row
+    const int cells = (m_width - 1) / 2;
+
+    // start from solid walls, then open cells (odd columns)
+    std::fill_n(above, m_width, Cell());
+    std::fill_n(row, m_width, Cell());
+    for (int j = 0; j < cells; ++j)
+    {
+        row[2 * j + 1].type = CellType::Path;
+    }
+
+    if (i == 0)
+    {
+        // top row can only open west: one straight corridor
+        for (int col = 1; col < m_width - 1; ++col)
+        {
+            row[col].type = CellType::Path;
+        }
+        return;
+    }
+
+    // one random bit per cell: 1 = north, 0 = west (left column always north)
+    std::uint64_t state = seed;
+    std::uint64_t bits = 0;
+    for (int j = 0; j < cells; ++j)
+    {
+        if ((j & 63) == 0)
+        {
+            bits = splitmix64(state);
+        }
+        bool north = j == 0 || (bits & 1);
+        bits >>= 1;
+
+        // branch-free stores: exactly one of the two walls is opened
+        above[2 * j + 1].type = north ? CellType::Path : CellType::Wall;
+        if (j > 0)
+        {
+            row[2 * j].type = north ? CellType::Wall : CellType::Path;
+        }
+    }
+}
+
+void Maze::carveRowSidewinder(int i, std::uint64_t seed)
+{
+    Cell* above = &m_grid[index(2 * i, 0)];     // wall row above (north passages)
+    Cell* row = &m_grid[index(2 * i + 1, 0)];   // cell row
+    const int cells = (m_width - 1) / 2;
+
+    std::fill_n(above, m_width, Cell());
+    std::fill_n(row, m_width, Cell());
+    for (int j = 0; j < cells; ++j)
+    {
+        row[2 * j + 1].type = CellType::Path;
+    }
+
+    if (i == 0)
+    {
+        // top row is a single run with no way north
+        for (int col = 1; col < m_width - 1; ++col)
+        {
+            row[col].type = CellType::Path;
+        }
+        return;
+    }
+
+    // one random bit per cell: 1 = close the run here (always at the east edge)
+    std::uint64_t state = seed;
+    std::uint64_t bits = 0;
+    int runStart = 0;
+    for (int j = 0; j < cells; ++j)
+    {
+        if ((j & 63) == 0)
+        {
+            bits = splitmix64(state);
+        }
+        bool close = j == cells - 1 || (bits & 1);
+        bits >>= 1;
+
+        if (close)
+        {
+            // open north from a random cell of the run
+            int k = runStart + static_cast<int>(splitmix64(state) % static_cast<std::uint64_t>(j - runStart + 1));
+            above[2 * k + 1].type = CellType::Path;
+            runStart = j + 1;
+        }
+        else
+        {
+            row[2 * j + 2].type = CellType::Path; // extend the run east
+        }
+    }
+}
+
+int Maze::getUnvisitedNeighbors(int row, int col, std::pair<int, int> neighbors[4]) const
+{
+    int count = 0;
+
     // Check all four directions (2 cells away for wall structure)
-    // Direction: {row_delta, col_delta}
-    const int directions[4][2] = {{-2, 0}, {2, 0}, {0, -2}, {0, 2}};
-    
-    for (const auto& dir : directions) 
+    // Direction: {row_delta, col_delta}; order fixes which maze a seed gives
+    static constexpr int directions[4][2] = {{-2, 0}, {2, 0}, {0, -2}, {0, 2}};
+
+    for (const auto& dir : directions)
     {
         int newRow = row + dir[0];
         int newCol = col + dir[1];
-        
+
         // Check bounds (staying within the border walls)
         if (newRow > 0 && newRow < m_height - 1 &&
-            newCol > 0 && newCol < m_width - 1) 
+            newCol > 0 && newCol < m_width - 1)
             {
-            if (!m_grid[newRow][newCol].visited) 
+            if (!m_grid[index(newRow, newCol)].visited)
             {
-                neighbors.push_back({newRow, newCol});
+                neighbors[count++] = {newRow, newCol};
             }
         }
     }
-    
-    return neighbors;
+
+    return count;
 }
 
 void Maze::placeStartAndEnd() 
 {
     // Place start in top-left area
     m_start = {1, 1};
-    m_grid[m_start.first][m_start.second].type = CellType::Start;
+    m_grid[index(m_start.first, m_start.second)].type = CellType::Start;
     
     // Place end in bottom-right area
     m_end = {m_height - 2, m_width - 2};
-    m_grid[m_end.first][m_end.second].type = CellType::End;
+    m_grid[index(m_end.first, m_end.second)].type = CellType::End;
 }
 
 void Maze::resetVisualization() 
 {
-    for (int row = 0; row < m_height; ++row) 
+    for (Cell& cell : m_grid) 
     {
-        for (int col = 0; col < m_width; ++col) 
+        if (cell.type == CellType::Visited || cell.type == CellType::Solution) 
         {
-            CellType type = m_grid[row][col].type;
-            if (type == CellType::Visited || type == CellType::Solution) 
-            {
-                m_grid[row][col].type = CellType::Path;
-            }
+            cell.type = CellType::Path;
         }
     }
     
     // Restore start and end markers
-    m_grid[m_start.first][m_start.second].type = CellType::Start;
-    m_grid[m_end.first][m_end.second].type = CellType::End;
+    m_grid[index(m_start.first, m_start.second)].type = CellType::Start;
+    m_grid[index(m_end.first, m_end.second)].type = CellType::End;
 }
 
 Cell& Maze::getCell(int row, int col) 
 {
-    return m_grid[row][col];
+    return m_grid[index(row, col)];
 }
 
 const Cell& Maze::getCell(int row, int col) const 
 {
-    return m_grid[row][col];
+    return m_grid[index(row, col)];
 }
 
 void Maze::setCellType(int row, int col, CellType type) 
 {
     if (isInBounds(row, col)) {
-        m_grid[row][col].type = type;
+        Cell& cell = m_grid[index(row, col)];
+        if ((cell.type == CellType::Wall) != (type == CellType::Wall))
+        {
+            m_generation = nextGeneration(); // the maze itself changed
+        }
+        cell.type = type;
     }
 }
 
@@ -183,64 +505,7 @@ bool Maze::isValidPath(int row, int col) const
         return false;
     }
     
-    CellType type = m_grid[row][col].type;
+    CellType type = m_grid[index(row, col)].type;
     return type != CellType::Wall;
 }
 
-
-// ============================================================================
-// ITERATIVE VERSION (Alternative implementation using explicit stack)
-// ============================================================================
-// 
-// For very large mazes, the recursive version may cause stack overflow.
-// Here's an iterative alternative that you can use instead:
-//
-// void Maze::generateIterative() 
-//{
-//     initializeGrid();
-//     
-//     std::stack<std::pair<int, int>> cellStack;
-//     
-//     // Start at (1, 1)
-//     int currentRow = 1;
-//     int currentCol = 1;
-//     m_grid[currentRow][currentCol].visited = true;
-//     m_grid[currentRow][currentCol].type = CellType::Path;
-//     
-//     int visitedCount = 1;
-//     int totalCells = ((m_height - 1) / 2) * ((m_width - 1) / 2);
-//     
-//     while (visitedCount < totalCells) {
-//         auto neighbors = getUnvisitedNeighbors(currentRow, currentCol);
-//         
-//         if (!neighbors.empty()) {
-//             // Choose random neighbor
-//             std::uniform_int_distribution<int> dist(0, neighbors.size() - 1);
-//             auto chosen = neighbors[dist(m_rng)];
-//             
-//             // Push current cell to stack
-//             cellStack.push({currentRow, currentCol});
-//             
-//             // Remove wall between current and chosen
-//             int wallRow = currentRow + (chosen.first - currentRow) / 2;
-//             int wallCol = currentCol + (chosen.second - currentCol) / 2;
-//             m_grid[wallRow][wallCol].type = CellType::Path;
-//             
-//             // Move to chosen cell
-//             currentRow = chosen.first;
-//             currentCol = chosen.second;
-//             m_grid[currentRow][currentCol].visited = true;
-//             m_grid[currentRow][currentCol].type = CellType::Path;
-//             visitedCount++;
-//         }
-//         else if (!cellStack.empty()) {
-//             // Backtrack
-//             auto cell = cellStack.top();
-//             cellStack.pop();
-//             currentRow = cell.first;
-//             currentCol = cell.second;
-//         }
-//     }
-//     
-//     placeStartAndEnd();
-// }
@@ -14,12 +14,17 @@
 #include <random>
 #include <stack>
 #include <utility>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <string>
 
 /**
  * @enum CellType
  * @brief Enumeration of possible cell states in the maze
  */
-enum class CellType 
+enum class CellType : std::uint8_t
 {
     Wall,       ///< Impassable wall
     Path,       ///< Open path that can be traversed
@@ -29,17 +34,98 @@ enum class CellType
     Solution    ///< Cell on the shortest path (for visualization)
 };
 
+/**
+ * @enum GeneratorAlgorithm
+ * @brief Algorithms available to Maze::generate
+ *
+ * All of them produce perfect mazes. Backtracker gives long winding
+ * corridors but is inherently sequential. BinaryTree and Sidewinder decide
+ * every row independently (from per-row random streams), so rows are
+ * carved in parallel at close to memory bandwidth - useful as bulk test
+ * data for the solvers. Their mazes have a visible bias (an open top row,
+ * and for BinaryTree an open left column too).
+ */
+enum class GeneratorAlgorithm
+{
+    Backtracker,    ///< Recursive backtracking (default)
+    BinaryTree,     ///< Each cell opens north or west
+    Sidewinder      ///< Runs along a row, each run opens north once
+};
+
+/**
+ * @brief Display/command-line name of a generator ("backtracker", ...)
+ */
+const char* generatorName(GeneratorAlgorithm algorithm);
+
+/**
+ * @brief Parse a generator name as printed by generatorName()
+ * @return true if the name was recognized
+ */
+bool parseGeneratorAlgorithm(const std::string& name, GeneratorAlgorithm& algorithm);
+
+/**
+ * @enum CellLayout
+ * @brief How Maze stores its cells in memory
+ *
+ * RowMajor keeps each grid row contiguous, so a vertical step jumps a
+ * whole row of memory; on wide mazes every such probe misses the cache.
+ * Tiled stores the grid as 8x8 blocks (row-major inside a block, blocks
+ * row-major across the grid): a 2-byte cell makes one block 128 bytes,
+ * and most vertical steps stay inside it. The grid is padded to whole
+ * blocks with wall cells.
+ */
+enum class CellLayout
+{
+    RowMajor,   ///< Row after row (default)
+    Tiled       ///< 8x8 cache blocks
+};
+
+/**
+ * @enum CellDirection
+ * @brief Neighbor directions for Maze::neighborIndex: the four
+ * orthogonal ones clockwise from north, then the four diagonals
+ * clockwise from north-east
+ */
+enum CellDirection : std::uint8_t
+{
+    DIR_NORTH = 0,
+    DIR_EAST = 1,
+    DIR_SOUTH = 2,
+    DIR_WEST = 3,
+    DIR_NORTHEAST = 4,
+    DIR_SOUTHEAST = 5,
+    DIR_SOUTHWEST = 6,
+    DIR_NORTHWEST = 7
+};
+
+/// Row and column offset of each CellDirection
+constexpr int DIRECTION_ROW[8] = {-1, 0, 1, 0, -1, 1, 1, -1};
+constexpr int DIRECTION_COL[8] = {0, 1, 0, -1, 1, 1, -1, -1};
+
+/**
+ * @brief Direction pointing back the way d came (N<->S, E<->W, NE<->SW, SE<->NW)
+ */
+constexpr int oppositeDirection(int d) { return d ^ 2; }
+
+/**
+ * @brief Orthogonal parts of a diagonal direction (its row step, its column step)
+ */
+constexpr int verticalPart(int d) { return DIRECTION_ROW[d] < 0 ? DIR_NORTH : DIR_SOUTH; }
+constexpr int horizontalPart(int d) { return DIRECTION_COL[d] > 0 ? DIR_EAST : DIR_WEST; }
+
 /**
  * @struct Cell
  * @brief Represents a single cell in the maze grid
+ *
+ * Kept to two bytes so very large grids (e.g. for headless export)
+ * still fit in memory. A cell's row/column is implied by its index.
  */
 struct Cell 
 {
     CellType type;
     bool visited;  // Used during maze generation
-    int row, col;
     
-    Cell() : type(CellType::Wall), visited(false), row(0), col(0) {}
+    Cell() : type(CellType::Wall), visited(false) {}
 };
 
 /**
@@ -57,17 +143,143 @@ public:
      * @brief Construct a new Maze object
      * @param width Number of cells horizontally (will be adjusted to odd number)
      * @param height Number of cells vertically (will be adjusted to odd number)
+     * @param maxDimension Upper clamp for width/height. The interactive game
+     *        keeps the default; headless tools may pass a larger value.
      */
-    Maze(int width, int height);
+    Maze(int width, int height, int maxDimension = 101);
     
     /**
      * @brief Generate a new random maze
      * 
      * Uses recursive backtracking algorithm to create a perfect maze
-     * (one with no loops and exactly one path between any two points)
+     * (one with no loops and exactly one path between any two points).
+     * The backtracking uses an explicit stack so large mazes cannot
+     * overflow the call stack.
      */
     void generate();
     
+    /**
+     * @brief Generate a new random maze, reporting progress and allowing
+     * cancellation (for running on a background thread)
+     * @param cancel checked periodically; set to true to abort
+     * @param progressPercent updated periodically with 0-100
+     * @return true if the maze was completed, false if cancelled
+     *         (the grid is then incomplete and must not be used)
+     */
+    bool generate(const std::atomic<bool>& cancel, std::atomic<int>& progressPercent);
+    
+    /**
+     * @brief Reseed the random generator so the next generate() is
+     * reproducible (same seed, size and algorithm -> same maze, for any
+     * thread count). Mazes are seeded from the clock by default.
+     */
+    void seed(std::uint32_t seed) { m_rng.seed(seed); }
+    
+    /**
+     * @brief Choose the algorithm used by the next generate()
+     */
+    void setAlgorithm(GeneratorAlgorithm algorithm) { m_algorithm = algorithm; }
+    GeneratorAlgorithm getAlgorithm() const { return m_algorithm; }
+    
+    /**
+     * @brief Worker threads for the row-parallel generators
+     * @param threads thread count, 0 = hardware concurrency
+     */
+    void setGeneratorThreads(unsigned threads) { m_generatorThreads = threads; }
+    
+    /**
+     * @brief Identifies the maze's current contents, for caching results
+     *
+     * Changes on every generate() and whenever setCellType opens or
+     * closes a cell (visualization markers leave it alone). Values are
+     * unique across all Maze objects; a copy keeps its source's value
+     * until either is changed.
+     */
+    std::uint64_t getGeneration() const { return m_generation; }
+    
+    /**
+     * @brief Choose how cells are stored; an existing grid is converted
+     * in place, so this may be called before or after generate()
+     */
+    void setLayout(CellLayout layout);
+    CellLayout getLayout() const { return m_layout; }
+    
+    /**
+     * @name Cell indices
+     * Solvers that keep per-cell arrays index them with these instead of
+     * row * width + col, so they work (and keep their locality) in any
+     * layout. Indices range over [0, getCellSlots()); in the Tiled layout
+     * some slots are padding walls outside the grid.
+     */
+    ///@{
+    std::size_t cellIndex(int row, int col) const { return index(row, col); }
+    std::size_t getCellSlots() const { return m_grid.size(); }
+    bool isOpen(std::size_t cell) const { return m_grid[cell].type != CellType::Wall; }
+    
+    /**
+     * @brief Row/column of a cell index (not valid for padding slots)
+     */
+    std::pair<int, int> cellPosition(std::size_t cell) const
+    {
+        if (m_layout == CellLayout::RowMajor)
+        {
+            return {static_cast<int>(cell / m_width), static_cast<int>(cell % m_width)};
+        }
+        std::size_t tile = cell >> (2 * TILE_SHIFT);
+        int tileRow = static_cast<int>(tile / m_tilesX);
+        int tileCol = static_cast<int>(tile - static_cast<std::size_t>(tileRow) * m_tilesX);
+        return {(tileRow << TILE_SHIFT) | static_cast<int>((cell >> TILE_SHIFT) & TILE_MASK),
+                (tileCol << TILE_SHIFT) | static_cast<int>(cell & TILE_MASK)};
+    }
+    
+    /**
+     * @brief Index of the neighbor one step in direction d (CellDirection,
+     * diagonals included)
+     *
+     * No bounds check: the cell must not lie on the outer border, which
+     * holds for every open cell since the generators always wall the
+     * grid in. The border walls act as sentinels for any search that
+     * only steps out of open cells.
+     */
+    std::size_t neighborIndex(std::size_t cell, int d) const
+    {
+        if (m_layout == CellLayout::RowMajor)
+        {
+            return cell + m_rowMajorStep[d];
+        }
+        if (d > DIR_WEST)
+        {
+            return neighborIndex(neighborIndex(cell, verticalPart(d)), horizontalPart(d));
+        }
+        // inside the block: +-1 / +-TILE_SIZE; across the block edge the
+        // step also moves to the neighboring block
+        const std::size_t tileCells = std::size_t(1) << (2 * TILE_SHIFT);
+        const std::size_t tileRowCells = tileCells * m_tilesX;
+        switch (d)
+        {
+            case DIR_NORTH:
+                return (cell & (TILE_MASK << TILE_SHIFT)) ? cell - TILE_SIZE : cell - tileRowCells + (tileCells - TILE_SIZE);
+            case DIR_SOUTH:
+                return (~cell & (TILE_MASK << TILE_SHIFT)) ? cell + TILE_SIZE : cell + tileRowCells - (tileCells - TILE_SIZE);
+            case DIR_WEST:
+                return (cell & TILE_MASK) ? cell - 1 : cell - tileCells + TILE_MASK;
+            default:
+                return (~cell & TILE_MASK) ? cell + 1 : cell + tileCells - TILE_MASK;
+        }
+    }
+    
+    /**
+     * @brief How many cells from (row, col) eastwards are stored
+     * contiguously, i.e. may be read through &getCell(row, col)
+     */
+    int contiguousCells(int row, int col) const
+    {
+        (void)row;
+        int run = m_layout == CellLayout::RowMajor ? m_width - col : TILE_SIZE - (col & TILE_MASK);
+        return std::min(run, m_width - col);
+    }
+    ///@}
+    
     /**
      * @brief Reset visualization markers (visited and solution cells)
      */
@@ -116,12 +328,22 @@ public:
     bool isInBounds(int row, int col) const;
 
 private:
+    static constexpr int TILE_SHIFT = 3;                    // 8x8 blocks
+    static constexpr int TILE_SIZE = 1 << TILE_SHIFT;
+    static constexpr std::size_t TILE_MASK = TILE_SIZE - 1;
+
     int m_width;
     int m_height;
-    std::vector<std::vector<Cell>> m_grid;
+    int m_tilesX;                   // blocks per block row (Tiled layout)
+    std::vector<Cell> m_grid;       // in m_layout order
+    std::ptrdiff_t m_rowMajorStep[8]; // neighborIndex offsets, by CellDirection
+    CellLayout m_layout = CellLayout::RowMajor;
+    std::uint64_t m_generation;
     std::pair<int, int> m_start;
     std::pair<int, int> m_end;
     std::mt19937 m_rng;
+    GeneratorAlgorithm m_algorithm = GeneratorAlgorithm::Backtracker;
+    unsigned m_generatorThreads = 0;
     
     /**
      * @brief Initialize the grid with all walls
@@ -129,19 +351,69 @@ private:
     void initializeGrid();
     
     /**
-     * @brief Recursive backtracking maze generation
-     * @param row Current row
-     * @param col Current column
+     * @brief Backtracking maze generation (iterative, explicit stack)
+     * @param row Starting row
+     * @param col Starting column
+     * @param cancel optional abort flag, nullptr if not cancellable
+     * @param progressPercent optional progress output, may be nullptr
+     * @return false if cancelled
+     */
+    bool carvePassages(int row, int col, const std::atomic<bool>* cancel, std::atomic<int>* progressPercent);
+    
+    /**
+     * @brief Row-parallel generation (BinaryTree / Sidewinder)
+     *
+     * Writes every cell itself, so no separate initializeGrid pass is
+     * needed. Maze row i (grid row 2i+1) and the wall row above it are
+     * owned by one thread, so threads never touch the same cells.
+     * @param cancel optional abort flag, nullptr if not cancellable
+     * @param progressPercent optional progress output, may be nullptr
+     * @return false if cancelled
+     */
+    bool carveRows(const std::atomic<bool>* cancel, std::atomic<int>* progressPercent);
+    
+    /**
+     * @brief Carve maze row i (grid rows 2i and 2i+1) with one algorithm
+     * @param i maze row (0-based, over odd grid rows)
+     * @param seed seed of this row's random stream
      */
-    void carvePassages(int row, int col);
+    void carveRowBinaryTree(int i, std::uint64_t seed);
+    void carveRowSidewinder(int i, std::uint64_t seed);
     
     /**
      * @brief Get unvisited neighbors for maze generation
      * @param row Current row
      * @param col Current column
-     * @return Vector of neighbor positions
+     * @param neighbors Output array receiving up to four neighbor positions
+     * @return Number of neighbors written
+     */
+    int getUnvisitedNeighbors(int row, int col, std::pair<int, int> neighbors[4]) const;
+    
+    /**
+     * @brief Flat index of a cell in m_grid
+     */
+    std::size_t index(int row, int col) const
+    {
+        return indexIn(m_layout, row, col);
+    }
+    
+    /**
+     * @brief Flat index of a cell under the given layout
+     */
+    std::size_t indexIn(CellLayout layout, int row, int col) const
+    {
+        if (layout == CellLayout::RowMajor)
+        {
+            return static_cast<std::size_t>(row) * m_width + col;
+        }
+        std::size_t tile = static_cast<std::size_t>(row >> TILE_SHIFT) * m_tilesX + (col >> TILE_SHIFT);
+        return (tile << (2 * TILE_SHIFT)) | ((row & TILE_MASK) << TILE_SHIFT) | (col & TILE_MASK);
+    }
+    
+    /**
+     * @brief Size of m_grid under the given layout
      */
-    std::vector<std::pair<int, int>> getUnvisitedNeighbors(int row, int col);
+    std::size_t slotsIn(CellLayout layout) const;
     
     /**
      * @brief Place start and end positions
@@ -0,0 +1,98 @@
+/**
+ * @file MazeProtocol.cpp
+ * @brief Socket helpers shared by the maze daemon and its clients
+ * @course ECE 4122/6122 - Homework 1
+ */
+
+#include "MazeProtocol.h"
+#include <cerrno>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define MAZE_HAVE_UNIX_SOCKETS 1
+#endif
+
+bool writeFully(int fd, const void* data, std::size_t size)
+{
+#ifdef MAZE_HAVE_UNIX_SOCKETS
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0)
+    {
+#ifdef MSG_NOSIGNAL
+        ssize_t written = send(fd, bytes, size, MSG_NOSIGNAL); // a closed peer is an error, not SIGPIPE
+#else
+        ssize_t written = write(fd, bytes, size);
+#endif
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            return false;
+        }
+        bytes += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+#else
+    (void)fd; (void)data; (void)size;
+    return false;
+#endif
+}
+
+bool readFully(int fd, void* data, std::size_t size)
+{
+#ifdef MAZE_HAVE_UNIX_SOCKETS
+    char* bytes = static_cast<char*>(data);
+    while (size > 0)
+    {
+        ssize_t got = read(fd, bytes, size);
+        if (got < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (got <= 0)
+        {
+            return false;
+        }
+        bytes += got;
+        size -= static_cast<std::size_t>(got);
+    }
+    return true;
+#else
+    (void)fd; (void)data; (void)size;
+    return false;
+#endif
+}
+
+int connectMazeServer(const char* socketPath)
+{
+#ifdef MAZE_HAVE_UNIX_SOCKETS
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (std::strlen(socketPath) >= sizeof(address.sun_path))
+    {
+        return -1;
+    }
+    std::strncpy(address.sun_path, socketPath, sizeof(address.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+#else
+    (void)socketPath;
+    return -1;
+#endif
+}
@@ -0,0 +1,123 @@
+/**
+ * @file MazeProtocol.h
+ * @brief Binary request/response frames of the maze query daemon
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * Clients talk to MazeServer over a Unix domain stream socket. Every
+ * request is one fixed-size MazeRequest; every response is one
+ * MazeResponse header followed by payloadBytes of payload. Both ends run
+ * on the same machine, so frames are plain structs in host byte order.
+ * Requests may be pipelined; responses carry the request id and, within
+ * one connection, come back in request order.
+ *
+ * A maze is identified by (seed, width, height, generator): the same key
+ * always names the same maze, which the daemon keeps resident together
+ * with its BFS tree from the start cell (parent direction and depth per
+ * cell). SOLVE and DISTANCE climb that tree from both endpoints to their
+ * common ancestor.
+ */
+
+#ifndef MAZE_PROTOCOL_H
+#define MAZE_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+/// First field of every request, guards against stray connections
+const std::uint32_t MAZE_PROTOCOL_MAGIC = 0x315A414D; // "MAZ1"
+
+/**
+ * @enum MazeOp
+ * @brief Request operations
+ */
+enum MazeOp : std::uint8_t
+{
+    MAZE_OP_GENERATE = 1,   ///< make the maze resident; value = open cells
+    MAZE_OP_SOLVE = 2,      ///< value = distance, payload = one direction byte per move
+    MAZE_OP_DISTANCE = 3,   ///< value = distance, no payload
+    MAZE_OP_SOLVE_PACKED = 4 ///< as SOLVE, but 2 bits per move (4 per byte, first move in the low bits; see CompactPath)
+};
+
+/**
+ * @enum MazeStatus
+ * @brief Response status codes
+ */
+enum MazeStatus : std::uint8_t
+{
+    MAZE_STATUS_OK = 0,
+    MAZE_STATUS_BAD_REQUEST = 1,    ///< unknown op/generator or bad magic
+    MAZE_STATUS_INVALID_CELL = 2,   ///< endpoint is a wall or out of bounds
+    MAZE_STATUS_NO_PATH = 3
+};
+
+/**
+ * Directions of a SOLVE / SOLVE_PACKED payload, applied from the
+ * request's start cell (same values as CellDirection).
+ */
+enum MazeDirection : std::uint8_t
+{
+    MAZE_DIR_NORTH = 0,
+    MAZE_DIR_EAST = 1,
+    MAZE_DIR_SOUTH = 2,
+    MAZE_DIR_WEST = 3
+};
+
+/**
+ * @struct MazeRequest
+ * @brief One request frame (40 bytes)
+ *
+ * Endpoint coordinates of -1 mean the maze's own start or end cell.
+ */
+struct MazeRequest
+{
+    std::uint32_t magic = MAZE_PROTOCOL_MAGIC;
+    std::uint32_t id = 0;           ///< echoed in the response
+    std::uint8_t op = MAZE_OP_GENERATE;
+    std::uint8_t generator = 0;     ///< static_cast of GeneratorAlgorithm
+    std::uint16_t reserved = 0;
+    std::uint32_t seed = 0;
+    std::int32_t width = 0;
+    std::int32_t height = 0;
+    std::int32_t fromRow = -1, fromCol = -1;
+    std::int32_t toRow = -1, toCol = -1;
+};
+
+/**
+ * @struct MazeResponse
+ * @brief Response header (32 bytes), followed by payloadBytes of payload
+ */
+struct MazeResponse
+{
+    std::uint32_t id = 0;
+    std::uint8_t op = 0;
+    std::uint8_t status = MAZE_STATUS_OK;
+    std::uint16_t reserved = 0;
+    std::int32_t width = 0;         ///< actual maze size (after Maze's clamping)
+    std::int32_t height = 0;
+    std::uint32_t payloadBytes = 0;
+    std::uint32_t reserved2 = 0;
+    std::int64_t value = 0;         ///< op dependent, see MazeOp
+};
+
+static_assert(sizeof(MazeRequest) == 40, "MazeRequest frame layout changed");
+static_assert(sizeof(MazeResponse) == 32, "MazeResponse frame layout changed");
+
+/**
+ * @brief Write exactly size bytes to a socket (retries short writes)
+ * @return false on error or closed peer
+ */
+bool writeFully(int fd, const void* data, std::size_t size);
+
+/**
+ * @brief Read exactly size bytes from a socket (retries short reads)
+ * @return false on error or closed peer
+ */
+bool readFully(int fd, void* data, std::size_t size);
+
+/**
+ * @brief Connect to a daemon's socket
+ * @return connected socket, or -1
+ */
+int connectMazeServer(const char* socketPath);
+
+#endif // MAZE_PROTOCOL_H
@@ -0,0 +1,369 @@
+/**
+ * @file MazeRasterizer.cpp
+ * @brief Implementation of the headless CPU maze rasterizer
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * Rendering works as follows:
+ * 1. Split the requested pixel rows into one contiguous chunk per thread.
+ * 2. For each pixel row, look up the palette index of every cell in the
+ *    matching maze row and repeat it `scale` times.
+ * 3. Pixel rows that map to the same maze row as the row above them are
+ *    copied instead of recomputed.
+ * 4. Each finished band is encoded (PNG stored-deflate or raw PPM) and
+ *    appended to the output file.
+ */
+
+#include "MazeRasterizer.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+const std::array<RGB, CELL_TYPE_COUNT> CELL_PALETTE = {{
+    {50, 50, 50},       // Wall: dark gray
+    {255, 255, 255},    // Path: white
+    {0, 200, 0},        // Start: green
+    {200, 0, 0},        // End: red
+    {173, 216, 230},    // Visited: light blue
+    {255, 255, 0}       // Solution: yellow
+}};
+
+namespace
+{
+    // cell type -> palette index; identity today but keeps the image palette
+    // independent of the enum ordering
+    const std::uint8_t CELL_TO_INDEX[CELL_TYPE_COUNT] = {0, 1, 2, 3, 4, 5};
+
+    unsigned resolveThreads(unsigned threads)
+    {
+        if (threads == 0)
+        {
+            threads = std::thread::hardware_concurrency();
+        }
+        return std::max(1u, threads);
+    }
+
+    // render pixel rows [first, first + count) of the image into out
+    void rasterizeChunk(const Maze& maze, int scale, int first, int count, std::uint8_t* out)
+    {
+        const int mazeWidth = maze.getWidth();
+        const std::size_t rowBytes = static_cast<std::size_t>(mazeWidth) * scale;
+
+        for (int i = 0; i < count; ++i)
+        {
+            int y = first + i;
+            std::uint8_t* dst = out + i * rowBytes;
+
+            // same maze row as the pixel row above: just copy it
+            if (i > 0 && y % scale != 0)
+            {
+                std::memcpy(dst, dst - rowBytes, rowBytes);
+                continue;
+            }
+
+            // a row is read in runs of contiguously stored cells (the
+            // whole row when row-major, one block width when tiled)
+            const int row = y / scale;
+            for (int col = 0; col < mazeWidth;)
+            {
+                const Cell* cells = &maze.getCell(row, col);
+                const int run = maze.contiguousCells(row, col);
+                std::uint8_t* pixels = dst + static_cast<std::size_t>(col) * scale;
+                if (scale == 1)
+                {
+                    for (int k = 0; k < run; ++k)
+                    {
+                        pixels[k] = CELL_TO_INDEX[static_cast<int>(cells[k].type)];
+                    }
+                }
+                else
+                {
+                    for (int k = 0; k < run; ++k)
+                    {
+                        std::memset(pixels + static_cast<std::size_t>(k) * scale,
+                                    CELL_TO_INDEX[static_cast<int>(cells[k].type)], scale);
+                    }
+                }
+                col += run;
+            }
+        }
+    }
+
+    // ---- PNG helpers ------------------------------------------------------
+
+    std::array<std::uint32_t, 256> buildCrcTable()
+    {
+        std::array<std::uint32_t, 256> table;
+        for (std::uint32_t n = 0; n < 256; ++n)
+        {
+            std::uint32_t c = n;
+            for (int k = 0; k < 8; ++k)
+            {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[n] = c;
+        }
+        return table;
+    }
+
+    std::uint32_t updateCrc(std::uint32_t crc, const std::uint8_t* data, std::size_t len)
+    {
+        static const std::array<std::uint32_t, 256> crcTable = buildCrcTable();
+        for (std::size_t i = 0; i < len; ++i)
+        {
+            crc = crcTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return crc;
+    }
+
+    void putBE32(std::vector<std::uint8_t>& buf, std::uint32_t v)
+    {
+        buf.push_back(static_cast<std::uint8_t>(v >> 24));
+        buf.push_back(static_cast<std::uint8_t>(v >> 16));
+        buf.push_back(static_cast<std::uint8_t>(v >> 8));
+        buf.push_back(static_cast<std::uint8_t>(v));
+    }
+
+    void writeChunk(std::ofstream& file, const char type[4], const std::vector<std::uint8_t>& data)
+    {
+        std::vector<std::uint8_t> header;
+        putBE32(header, static_cast<std::uint32_t>(data.size()));
+        header.insert(header.end(), type, type + 4);
+
+        std::uint32_t crc = updateCrc(0xFFFFFFFFu, header.data() + 4, 4);
+        crc = updateCrc(crc, data.data(), data.size()) ^ 0xFFFFFFFFu;
+
+        std::vector<std::uint8_t> trailer;
+        putBE32(trailer, crc);
+
+        file.write(reinterpret_cast<const char*>(header.data()), header.size());
+        file.write(reinterpret_cast<const char*>(data.data()), data.size());
+        file.write(reinterpret_cast<const char*>(trailer.data()), trailer.size());
+    }
+
+    /**
+     * Incremental zlib stream made only of stored (uncompressed) deflate
+     * blocks. Maze images are mostly long runs, but compressing would cost
+     * far more CPU than writing; stored blocks keep export memory-bound.
+     */
+    class StoredZlibWriter
+    {
+    public:
+        explicit StoredZlibWriter(std::uint64_t totalBytes) : m_remaining(totalBytes), m_a(1), m_b(0), m_started(false) {}
+
+        // append raw bytes as stored blocks, writing the zlib-framed bytes to out
+        void append(const std::uint8_t* data, std::size_t len, std::vector<std::uint8_t>& out)
+        {
+            if (!m_started)
+            {
+                out.push_back(0x78); // deflate, 32K window
+                out.push_back(0x01); // no preset dictionary, fastest
+                m_started = true;
+            }
+            while (len > 0)
+            {
+                std::size_t block = std::min<std::size_t>(len, 65535);
+                m_remaining -= block;
+                out.push_back(m_remaining == 0 ? 1 : 0); // BFINAL, BTYPE = 00
+                out.push_back(static_cast<std::uint8_t>(block & 0xFF));
+                out.push_back(static_cast<std::uint8_t>(block >> 8));
+                out.push_back(static_cast<std::uint8_t>(~block & 0xFF));
+                out.push_back(static_cast<std::uint8_t>((~block >> 8) & 0xFF));
+                out.insert(out.end(), data, data + block);
+                updateAdler(data, block);
+                data += block;
+                len -= block;
+            }
+            if (m_remaining == 0)
+            {
+                putBE32(out, (m_b << 16) | m_a);
+            }
+        }
+
+    private:
+        void updateAdler(const std::uint8_t* data, std::size_t len)
+        {
+            // defer the modulo: 5552 is the largest run that cannot overflow
+            while (len > 0)
+            {
+                std::size_t run = std::min<std::size_t>(len, 5552);
+                for (std::size_t i = 0; i < run; ++i)
+                {
+                    m_a += data[i];
+                    m_b += m_a;
+                }
+                m_a %= 65521;
+                m_b %= 65521;
+                data += run;
+                len -= run;
+            }
+        }
+
+        std::uint64_t m_remaining;
+        std::uint32_t m_a, m_b;
+        bool m_started;
+    };
+}
+
+ImageFormat formatFromPath(const std::string& path)
+{
+    std::string ext = path.size() >= 4 ? path.substr(path.size() - 4) : "";
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext == ".ppm" ? ImageFormat::PPM : ImageFormat::PNG;
+}
+
+void rasterizeRows(const Maze& maze, int scale, int firstRow, int rowCount, std::uint8_t* out, unsigned threads)
+{
+    const std::size_t rowBytes = static_cast<std::size_t>(maze.getWidth()) * scale;
+    threads = std::min<unsigned>(resolveThreads(threads), static_cast<unsigned>(std::max(rowCount, 1)));
+
+    if (threads == 1)
+    {
+        rasterizeChunk(maze, scale, firstRow, rowCount, out);
+        return;
+    }
+
+    // contiguous stripe of rows per thread keeps each writer on its own pages
+    std::vector<std::thread> workers;
+    int perThread = (rowCount + static_cast<int>(threads) - 1) / static_cast<int>(threads);
+    for (int start = 0; start < rowCount; start += perThread)
+    {
+        int count = std::min(perThread, rowCount - start);
+        workers.emplace_back(rasterizeChunk, std::cref(maze), scale, firstRow + start, count, out + start * rowBytes);
+    }
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+bool exportMazeImage(const Maze& maze, const std::string& path, ImageFormat format, const RasterOptions& options)
+{
+    const int scale = std::max(1, options.scale);
+    const std::uint64_t imageWidth = static_cast<std::uint64_t>(maze.getWidth()) * scale;
+    const std::uint64_t imageHeight = static_cast<std::uint64_t>(maze.getHeight()) * scale;
+    if (imageWidth > 0x7FFFFFFF || imageHeight > 0x7FFFFFFF)
+    {
+        return false; // beyond what PNG/PPM headers (and int rows) can describe
+    }
+    const std::size_t rowBytes = static_cast<std::size_t>(imageWidth);
+
+    // default band: roughly 64 MB of palette indices in flight at once
+    int bandRows = options.bandRows;
+    if (bandRows <= 0)
+    {
+        bandRows = static_cast<int>(std::max<std::size_t>(1, (64u << 20) / rowBytes));
+    }
+    bandRows = std::min<int>(bandRows, static_cast<int>(imageHeight));
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    std::vector<std::uint8_t> band(static_cast<std::size_t>(bandRows) * rowBytes);
+
+    if (format == ImageFormat::PPM)
+    {
+        file << "P6\n" << imageWidth << " " << imageHeight << "\n255\n";
+
+        std::vector<std::uint8_t> rgbRow(rowBytes * 3);
+        for (int y = 0; y < static_cast<int>(imageHeight); y += bandRows)
+        {
+            int rows = std::min(bandRows, static_cast<int>(imageHeight) - y);
+            rasterizeRows(maze, scale, y, rows, band.data(), options.threads);
+            for (int r = 0; r < rows; ++r)
+            {
+                const std::uint8_t* src = band.data() + r * rowBytes;
+                for (std::size_t x = 0; x < rowBytes; ++x)
+                {
+                    const RGB& color = CELL_PALETTE[src[x]];
+                    rgbRow[3 * x] = color.r;
+                    rgbRow[3 * x + 1] = color.g;
+                    rgbRow[3 * x + 2] = color.b;
+                }
+                file.write(reinterpret_cast<const char*>(rgbRow.data()), rgbRow.size());
+            }
+        }
+        return static_cast<bool>(file);
+    }
+
+    // PNG: signature, header, palette, one IDAT per band, end marker
+    const std::uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    file.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+    std::vector<std::uint8_t> ihdr;
+    putBE32(ihdr, static_cast<std::uint32_t>(imageWidth));
+    putBE32(ihdr, static_cast<std::uint32_t>(imageHeight));
+    ihdr.push_back(8);  // bit depth
+    ihdr.push_back(3);  // color type: indexed
+    ihdr.push_back(0);  // compression
+    ihdr.push_back(0);  // filter
+    ihdr.push_back(0);  // interlace
+    writeChunk(file, "IHDR", ihdr);
+
+    std::vector<std::uint8_t> plte;
+    for (const RGB& color : CELL_PALETTE)
+    {
+        plte.push_back(color.r);
+        plte.push_back(color.g);
+        plte.push_back(color.b);
+    }
+    writeChunk(file, "PLTE", plte);
+
+    // every scanline is prefixed with filter type 0 (none)
+    StoredZlibWriter zlib(imageHeight * (rowBytes + 1));
+    std::vector<std::uint8_t> scanlines(static_cast<std::size_t>(bandRows) * (rowBytes + 1));
+    std::vector<std::uint8_t> idat;
+    for (int y = 0; y < static_cast<int>(imageHeight); y += bandRows)
+    {
+        int rows = std::min(bandRows, static_cast<int>(imageHeight) - y);
+        rasterizeRows(maze, scale, y, rows, band.data(), options.threads);
+        for (int r = 0; r < rows; ++r)
+        {
+            std::uint8_t* line = scanlines.data() + r * (rowBytes + 1);
+            line[0] = 0;
+            std::memcpy(line + 1, band.data() + r * rowBytes, rowBytes);
+        }
+
+        idat.clear();
+        zlib.append(scanlines.data(), rows * (rowBytes + 1), idat);
+        writeChunk(file, "IDAT", idat);
+    }
+
+    writeChunk(file, "IEND", {});
+    return static_cast<bool>(file);
+}
+
+SolveFrameExporter::SolveFrameExporter(const std::string& prefix, ImageFormat format, const RasterOptions& options, int every)
+    : m_prefix(prefix), m_format(format), m_options(options), m_every(std::max(1, every)), m_calls(0), m_frame(0),
+      m_failed(0)
+{
+}
+
+void SolveFrameExporter::capture(const Maze& maze)
+{
+    if (++m_calls % m_every == 0)
+    {
+        flush(maze);
+    }
+}
+
+bool SolveFrameExporter::flush(const Maze& maze)
+{
+    char number[16];
+    std::snprintf(number, sizeof(number), "_%05d", m_frame++);
+    std::string path = m_prefix + number + (m_format == ImageFormat::PPM ? ".ppm" : ".png");
+    if (exportMazeImage(maze, path, m_format, m_options))
+    {
+        return true;
+    }
+    if (m_failed++ == 0)
+    {
+        m_firstFailure = path;
+    }
+    return false;
+}
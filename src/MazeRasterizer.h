@@ -0,0 +1,148 @@
+/**
+ * @file MazeRasterizer.h
+ * @brief Pure-CPU maze rendering to PNG/PPM images (no window or GPU needed)
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * The rasterizer turns the maze grid (including Visited/Solution overlay)
+ * into an 8-bit palette image. Rows are split across worker threads and
+ * each cell type is converted to a color through lookup tables, so the
+ * cost per pixel is one table read and one byte store.
+ *
+ * Images are written in bands of rows, so even a 20000x20000 maze can be
+ * exported without holding the full image in memory.
+ */
+
+#ifndef MAZE_RASTERIZER_H
+#define MAZE_RASTERIZER_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "MazeGenerator.h"
+
+/**
+ * @struct RGB
+ * @brief 8-bit per channel color used by the rasterizer palette
+ */
+struct RGB
+{
+    std::uint8_t r, g, b;
+};
+
+/// Number of CellType values (size of the color lookup table)
+const int CELL_TYPE_COUNT = 6;
+
+/**
+ * @brief Color lookup table indexed by static_cast<int>(CellType).
+ * Shared with the SFML renderer so window and exported images match.
+ */
+extern const std::array<RGB, CELL_TYPE_COUNT> CELL_PALETTE;
+
+/**
+ * @enum ImageFormat
+ * @brief Output file formats supported by the rasterizer
+ */
+enum class ImageFormat
+{
+    PNG,    ///< Indexed-color PNG (stored deflate blocks, no zlib needed)
+    PPM     ///< Binary P6 PPM
+};
+
+/**
+ * @struct RasterOptions
+ * @brief Settings for a headless export
+ */
+struct RasterOptions
+{
+    int scale = 1;              ///< Pixels per cell edge (1 = one pixel per cell)
+    unsigned threads = 0;       ///< Worker threads (0 = hardware concurrency)
+    int bandRows = 0;           ///< Pixel rows rendered per band (0 = automatic)
+};
+
+/**
+ * @brief Pick an image format from a file name (".ppm" -> PPM, anything else PNG)
+ */
+ImageFormat formatFromPath(const std::string& path);
+
+/**
+ * @brief Rasterize a range of pixel rows into palette indices.
+ * @param maze Maze to render (read only)
+ * @param scale Pixels per cell edge
+ * @param firstRow First pixel row to render
+ * @param rowCount Number of pixel rows to render
+ * @param out Destination, rowCount * (maze width * scale) bytes
+ * @param threads Worker threads to split the rows across
+ */
+void rasterizeRows(const Maze& maze, int scale, int firstRow, int rowCount, std::uint8_t* out, unsigned threads);
+
+/**
+ * @brief Render the maze and its overlay to an image file.
+ * @param maze Maze to render (read only)
+ * @param path Output file name
+ * @param format PNG or PPM
+ * @param options Scale, thread count and band size
+ * @return true if the file was written successfully
+ */
+bool exportMazeImage(const Maze& maze, const std::string& path, ImageFormat format, const RasterOptions& options);
+
+/**
+ * @class SolveFrameExporter
+ * @brief Writes numbered frames of a solve to disk.
+ *
+ * Hook capture() into the solver's renderer callback; every Nth call
+ * writes <prefix>_00000.<ext>, <prefix>_00001.<ext>, ...
+ * A frame that cannot be written (bad prefix, full disk) does not stop
+ * the solve; check failed() afterwards.
+ */
+class SolveFrameExporter
+{
+public:
+    /**
+     * @param prefix File name prefix (may contain a directory)
+     * @param format PNG or PPM
+     * @param options Raster settings used for every frame
+     * @param every Write one frame per this many capture() calls
+     */
+    SolveFrameExporter(const std::string& prefix, ImageFormat format, const RasterOptions& options, int every);
+
+    /**
+     * @brief Count one solver step, writing a frame if it is due
+     * @param maze Maze in its current (partially solved) state
+     */
+    void capture(const Maze& maze);
+
+    /**
+     * @brief Unconditionally write a frame (e.g. the final solved state)
+     * @return false if the frame could not be written
+     */
+    bool flush(const Maze& maze);
+
+    /**
+     * @brief Number of frames attempted so far (written or failed)
+     */
+    int getFrameCount() const { return m_frame; }
+
+    /**
+     * @brief Whether any frame failed to write
+     */
+    bool failed() const { return m_failed > 0; }
+    int getFailedCount() const { return m_failed; }
+
+    /**
+     * @brief Path of the first frame that failed, empty if none did
+     */
+    const std::string& getFirstFailure() const { return m_firstFailure; }
+
+private:
+    std::string m_prefix;
+    ImageFormat m_format;
+    RasterOptions m_options;
+    int m_every;
+    int m_calls;
+    int m_frame;
+    int m_failed;
+    std::string m_firstFailure;
+};
+
+#endif // MAZE_RASTERIZER_H
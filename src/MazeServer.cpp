@@ -0,0 +1,510 @@
+/**
+ * @file MazeServer.cpp
+ * @brief Implementation of the maze query daemon
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * The socket loop is single threaded: poll() for readable clients, read
+ * whatever they sent, cut it into whole request frames, answer all of
+ * them as one batch, then queue each client's replies and write what the
+ * socket accepts. Client sockets are non-blocking; the rest of a reply
+ * queue goes out on POLLOUT, so one client that pipelines requests
+ * without reading replies cannot block the loop. Only the batch itself
+ * fans out to worker threads.
+ */
+
+#include "MazeServer.h"
+#include "CompactPath.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define MAZE_HAVE_UNIX_SOCKETS 1
+#endif
+
+namespace
+{
+    // inverse of the MazeDirection encoding
+    const int DIR_ROW[4] = {-1, 0, 1, 0};
+    const int DIR_COL[4] = {0, 1, 0, -1};
+}
+
+static_assert(static_cast<long long>(MazeServer::MAX_DIMENSION) * MazeServer::MAX_DIMENSION <= INT32_MAX,
+              "depths of the largest maze must fit std::int32_t");
+
+bool MazeServer::CacheKey::operator<(const CacheKey& other) const
+{
+    if (seed != other.seed) return seed < other.seed;
+    if (width != other.width) return width < other.width;
+    if (height != other.height) return height < other.height;
+    return generator < other.generator;
+}
+
+MazeServer::MazeServer(const MazeServerOptions& options)
+    : m_options(options), m_listenFd(-1), m_clock(0)
+{
+    m_options.maxDimension = std::min(m_options.maxDimension, MAX_DIMENSION);
+}
+
+MazeServer::~MazeServer()
+{
+#ifdef MAZE_HAVE_UNIX_SOCKETS
+    if (m_listenFd >= 0)
+    {
+        close(m_listenFd);
+        unlink(m_options.socketPath.c_str());
+    }
+#endif
+}
+
+bool MazeServer::start()
+{
+#ifdef MAZE_HAVE_UNIX_SOCKETS
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (m_options.socketPath.size() >= sizeof(address.sun_path))
+    {
+        return false;
+    }
+    std::strncpy(address.sun_path, m_options.socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    m_listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (m_listenFd < 0)
+    {
+        return false;
+    }
+    unlink(m_options.socketPath.c_str()); // left behind by a previous run
+    if (bind(m_listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(m_listenFd, 64) != 0)
+    {
+        close(m_listenFd);
+        m_listenFd = -1;
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+void MazeServer::run(const std::atomic<bool>& stop)
+{
+#ifdef MAZE_HAVE_UNIX_SOCKETS
+    struct Client
+    {
+        int fd;
+        std::vector<std::uint8_t> input;    // bytes not yet forming a whole frame
+        std::vector<std::uint8_t> output;   // replies not yet accepted by the socket
+        std::size_t sent;                   // bytes of output already written
+
+        std::size_t pending() const { return output.size() - sent; }
+    };
+    std::vector<Client> clients;
+    std::vector<pollfd> fds;
+    std::vector<std::uint8_t> buffer(1 << 16);
+
+    // write as much queued output as the socket takes without blocking
+    auto flush = [](Client& client) {
+        while (client.sent < client.output.size())
+        {
+#ifdef MSG_NOSIGNAL
+            ssize_t written = send(client.fd, client.output.data() + client.sent, client.pending(), MSG_NOSIGNAL);
+#else
+            ssize_t written = write(client.fd, client.output.data() + client.sent, client.pending());
+#endif
+            if (written < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            {
+                break; // socket full: wait for POLLOUT
+            }
+            if (written <= 0)
+            {
+                return false;
+            }
+            client.sent += static_cast<std::size_t>(written);
+        }
+        if (client.sent == client.output.size())
+        {
+            client.output.clear();
+            client.sent = 0;
+        }
+        else if (client.sent > client.output.size() / 2)
+        {
+            client.output.erase(client.output.begin(), client.output.begin() + client.sent);
+            client.sent = 0;
+        }
+        return true;
+    };
+
+    while (!stop)
+    {
+        // a client that does not read its replies is not read from either,
+        // so its backlog stays bounded and it cannot stall the others
+        fds.clear();
+        fds.push_back({m_listenFd, POLLIN, 0});
+        for (const Client& client : clients)
+        {
+            short events = client.pending() < m_options.maxPendingOutput ? POLLIN : 0;
+            if (client.pending() > 0)
+            {
+                events |= POLLOUT;
+            }
+            fds.push_back({client.fd, events, 0});
+        }
+        if (poll(fds.data(), fds.size(), 200) <= 0)
+        {
+            continue; // timeout (re-check stop) or EINTR
+        }
+        MAZE_TRACE_ZONE("MazeServer::poll");
+
+        // read everything that arrived, flush what can be written;
+        // clients are indexed like fds[1..]
+        std::vector<bool> closed(clients.size(), false);
+        for (std::size_t i = 0; i < clients.size(); ++i)
+        {
+            short revents = fds[i + 1].revents;
+            if ((revents & POLLOUT) && !flush(clients[i]))
+            {
+                closed[i] = true;
+                continue;
+            }
+            if (!(revents & (POLLIN | POLLHUP | POLLERR)))
+            {
+                continue;
+            }
+            ssize_t got = read(clients[i].fd, buffer.data(), buffer.size());
+            if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+            {
+                continue;
+            }
+            if (got <= 0)
+            {
+                closed[i] = true;
+                continue;
+            }
+            clients[i].input.insert(clients[i].input.end(), buffer.begin(), buffer.begin() + got);
+        }
+
+        // every whole frame from every client with room for replies joins this batch
+        std::vector<MazeRequest> batch;
+        std::vector<std::size_t> owner;
+        for (std::size_t i = 0; i < clients.size(); ++i)
+        {
+            if (closed[i] || clients[i].pending() >= m_options.maxPendingOutput)
+            {
+                continue;
+            }
+            std::vector<std::uint8_t>& input = clients[i].input;
+            std::size_t frames = input.size() / sizeof(MazeRequest);
+            for (std::size_t f = 0; f < frames; ++f)
+            {
+                MazeRequest request;
+                std::memcpy(&request, input.data() + f * sizeof(MazeRequest), sizeof(MazeRequest));
+                batch.push_back(request);
+                owner.push_back(i);
+            }
+            input.erase(input.begin(), input.begin() + frames * sizeof(MazeRequest));
+        }
+
+        if (!batch.empty())
+        {
+            std::vector<MazeReply> replies = processBatch(batch);
+
+            // queue replies in request order, then write what fits right away
+            for (std::size_t r = 0; r < replies.size(); ++r)
+            {
+                std::vector<std::uint8_t>& out = clients[owner[r]].output;
+                const std::uint8_t* header = reinterpret_cast<const std::uint8_t*>(&replies[r].header);
+                out.insert(out.end(), header, header + sizeof(MazeResponse));
+                out.insert(out.end(), replies[r].payload.begin(), replies[r].payload.end());
+            }
+            for (std::size_t i = 0; i < clients.size(); ++i)
+            {
+                if (!closed[i] && clients[i].pending() > 0 && !flush(clients[i]))
+                {
+                    closed[i] = true;
+                }
+            }
+        }
+
+        for (std::size_t i = clients.size(); i-- > 0;)
+        {
+            if (closed[i])
+            {
+                close(clients[i].fd);
+                clients.erase(clients.begin() + i);
+            }
+        }
+
+        if (fds[0].revents & POLLIN)
+        {
+            int fd = accept(m_listenFd, nullptr, nullptr);
+            if (fd >= 0)
+            {
+                fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+                clients.push_back({fd, {}, {}, 0});
+            }
+        }
+    }
+
+    for (const Client& client : clients)
+    {
+        close(client.fd);
+    }
+#else
+    (void)stop;
+#endif
+}
+
+std::vector<MazeReply> MazeServer::processBatch(const std::vector<MazeRequest>& requests)
+{
+    MAZE_TRACE_ZONE("MazeServer::processBatch");
+    m_clock++;
+    m_stats.batches++;
+    m_stats.requests += requests.size();
+    m_stats.largestBatch = std::max<std::uint64_t>(m_stats.largestBatch, requests.size());
+
+    std::vector<MazeReply> replies(requests.size());
+
+    // validate, then group the valid requests by maze
+    std::map<CacheKey, std::vector<std::size_t>> groups;
+    for (std::size_t i = 0; i < requests.size(); ++i)
+    {
+        const MazeRequest& request = requests[i];
+        MazeResponse& header = replies[i].header;
+        header.id = request.id;
+        header.op = request.op;
+
+        bool validOp = request.op == MAZE_OP_GENERATE || request.op == MAZE_OP_SOLVE || request.op == MAZE_OP_DISTANCE ||
+                       request.op == MAZE_OP_SOLVE_PACKED;
+        if (request.magic != MAZE_PROTOCOL_MAGIC || !validOp ||
+            request.generator > static_cast<std::uint8_t>(GeneratorAlgorithm::Sidewinder))
+        {
+            header.status = MAZE_STATUS_BAD_REQUEST;
+            continue;
+        }
+        CacheKey key = {request.seed, request.width, request.height, request.generator};
+        groups[key].push_back(i);
+    }
+
+    // look up (or reserve) every maze on this thread; workers only fill entries in
+    struct WorkItem
+    {
+        const CacheKey* key;
+        CacheEntry* entry;
+        const std::vector<std::size_t>* requests;
+    };
+    std::vector<WorkItem> work;
+    for (auto& group : groups)
+    {
+        auto found = m_cache.find(group.first);
+        if (found == m_cache.end())
+        {
+            found = m_cache.emplace(group.first, CacheEntry()).first;
+        }
+        else
+        {
+            m_stats.cacheHits += group.second.size();
+        }
+        found->second.lastUsed = m_clock;
+        work.push_back({&found->first, &found->second, &group.second});
+    }
+
+    unsigned threads = m_options.threads ? m_options.threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<unsigned>(threads, static_cast<unsigned>(work.size()));
+    // a lone maze may use every core for its own generation
+    unsigned generatorThreads = work.size() == 1 ? 0 : 1;
+
+    std::atomic<std::size_t> next(0);
+    std::atomic<std::uint64_t> generated(0);
+    auto worker = [&]() {
+        for (std::size_t w = next++; w < work.size(); w = next++)
+        {
+            CacheEntry& entry = *work[w].entry;
+            if (!entry.maze)
+            {
+                prepare(*work[w].key, entry, generatorThreads);
+                generated++;
+            }
+            for (std::size_t i : *work[w].requests)
+            {
+                answer(entry, requests[i], replies[i]);
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; ++t)
+    {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : workers)
+    {
+        thread.join();
+    }
+    m_stats.generated += generated;
+
+    evict();
+    return replies;
+}
+
+void MazeServer::prepare(const CacheKey& key, CacheEntry& entry, unsigned generatorThreads)
+{
+    MAZE_TRACE_ZONE("MazeServer::prepare");
+    entry.maze.reset(new Maze(key.width, key.height, m_options.maxDimension));
+    entry.maze->seed(key.seed);
+    entry.maze->setAlgorithm(static_cast<GeneratorAlgorithm>(key.generator));
+    entry.maze->setGeneratorThreads(generatorThreads);
+    entry.maze->generate();
+
+    // BFS tree from the start; queue and index share flat cell numbers
+    const Maze& maze = *entry.maze;
+    const int width = maze.getWidth();
+    const std::size_t cells = static_cast<std::size_t>(width) * maze.getHeight();
+    entry.parentDirection.assign(cells, 0);
+    entry.depth.assign(cells, -1);
+
+    std::vector<std::size_t> queue;
+    queue.reserve(cells / 2);
+    std::size_t start = static_cast<std::size_t>(maze.getStart().first) * width + maze.getStart().second;
+    entry.depth[start] = 0;
+    queue.push_back(start);
+    for (std::size_t head = 0; head < queue.size(); ++head)
+    {
+        std::size_t cell = queue[head];
+        int row = static_cast<int>(cell / width), col = static_cast<int>(cell % width);
+        for (int d = 0; d < 4; ++d)
+        {
+            int nextRow = row + DIR_ROW[d], nextCol = col + DIR_COL[d];
+            if (!maze.isValidPath(nextRow, nextCol))
+            {
+                continue;
+            }
+            std::size_t next = static_cast<std::size_t>(nextRow) * width + nextCol;
+            if (entry.depth[next] < 0)
+            {
+                entry.depth[next] = entry.depth[cell] + 1;
+                entry.parentDirection[next] = static_cast<std::uint8_t>((d + 2) & 3);
+                queue.push_back(next);
+            }
+        }
+    }
+    entry.openCells = static_cast<std::int64_t>(queue.size());
+}
+
+void MazeServer::answer(CacheEntry& entry, const MazeRequest& request, MazeReply& reply)
+{
+    const Maze& maze = *entry.maze;
+    MazeResponse& header = reply.header;
+    header.width = maze.getWidth();
+    header.height = maze.getHeight();
+
+    if (request.op == MAZE_OP_GENERATE)
+    {
+        header.value = entry.openCells;
+        return;
+    }
+
+    Position from = {request.fromRow, request.fromCol};
+    Position to = {request.toRow, request.toCol};
+    if (from.row < 0 && from.col < 0)
+    {
+        from = {maze.getStart().first, maze.getStart().second};
+    }
+    if (to.row < 0 && to.col < 0)
+    {
+        to = {maze.getEnd().first, maze.getEnd().second};
+    }
+    if (!maze.isValidPath(from.row, from.col) || !maze.isValidPath(to.row, to.col))
+    {
+        header.status = MAZE_STATUS_INVALID_CELL;
+        return;
+    }
+
+    const int width = maze.getWidth();
+    std::size_t a = static_cast<std::size_t>(from.row) * width + from.col;
+    std::size_t b = static_cast<std::size_t>(to.row) * width + to.col;
+    if (entry.depth[a] < 0 || entry.depth[b] < 0)
+    {
+        header.status = MAZE_STATUS_NO_PATH;
+        return;
+    }
+
+    // climb both ends to their common ancestor. Moves from 'from' are
+    // recorded as taken; moves from 'to' are recorded upwards and
+    // appended reversed and inverted afterwards.
+    const bool solve = request.op == MAZE_OP_SOLVE || request.op == MAZE_OP_SOLVE_PACKED;
+    std::vector<std::uint8_t> fromTo;
+    std::int64_t upFrom = 0, upTo = 0;
+    const std::ptrdiff_t rowStep = width;
+    auto climb = [&](std::size_t& cell, std::int64_t& steps, bool recordFrom) {
+        std::uint8_t d = entry.parentDirection[cell];
+        if (solve && recordFrom)
+        {
+            reply.payload.push_back(d);
+        }
+        else if (solve)
+        {
+            fromTo.push_back(static_cast<std::uint8_t>((d + 2) & 3));
+        }
+        cell += DIR_ROW[d] * rowStep + DIR_COL[d];
+        steps++;
+    };
+    while (entry.depth[a] > entry.depth[b])
+    {
+        climb(a, upFrom, true);
+    }
+    while (entry.depth[b] > entry.depth[a])
+    {
+        climb(b, upTo, false);
+    }
+    while (a != b)
+    {
+        climb(a, upFrom, true);
+        climb(b, upTo, false);
+    }
+
+    header.value = upFrom + upTo;
+    if (solve)
+    {
+        reply.payload.insert(reply.payload.end(), fromTo.rbegin(), fromTo.rend());
+        if (request.op == MAZE_OP_SOLVE_PACKED)
+        {
+            CompactPath packed(from);
+            packed.reserve(reply.payload.size());
+            for (std::uint8_t d : reply.payload)
+            {
+                packed.push(d);
+            }
+            reply.payload = packed.getBytes();
+        }
+        header.payloadBytes = static_cast<std::uint32_t>(reply.payload.size());
+    }
+}
+
+void MazeServer::evict()
+{
+    while (m_cache.size() > m_options.cacheEntries)
+    {
+        auto oldest = m_cache.begin();
+        for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
+        {
+            if (it->second.lastUsed < oldest->second.lastUsed)
+            {
+                oldest = it;
+            }
+        }
+        m_cache.erase(oldest);
+        m_stats.evictions++;
+    }
+}
@@ -0,0 +1,163 @@
+/**
+ * @file MazeServer.h
+ * @brief Headless daemon answering maze queries over a Unix domain socket
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * The server keeps generated mazes resident, keyed by (seed, size,
+ * generator), each with a path index so solve and distance queries
+ * between arbitrary cells do not search the maze. Generated mazes are
+ * perfect, i.e. trees, so the index is simply the BFS tree from the
+ * start cell: a parent direction and a depth per cell. A query climbs
+ * from both endpoints to their common ancestor, touching only the cells
+ * of the answer. The least recently used mazes are dropped once more
+ * than cacheEntries are resident.
+ *
+ * Requests that arrive together (pipelined by one client, or sent by
+ * several clients during the same poll) form one batch. A batch is
+ * grouped by maze, each missing maze is generated once, and the groups
+ * are answered in parallel, one thread per maze. Replies are queued per
+ * client and written without blocking; a client whose queue exceeds
+ * maxPendingOutput is not read from until it has taken its replies.
+ *
+ * See MazeProtocol.h for the frames. Only available on POSIX systems.
+ */
+
+#ifndef MAZE_SERVER_H
+#define MAZE_SERVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "MazeGenerator.h"
+#include "Pathfinder.h" // Position
+#include "MazeProtocol.h"
+
+/**
+ * @struct MazeServerOptions
+ * @brief Daemon settings
+ */
+struct MazeServerOptions
+{
+    std::string socketPath = "/tmp/mazed.sock";
+    std::size_t cacheEntries = 16;  ///< resident mazes kept
+    unsigned threads = 0;           ///< batch workers (0 = hardware concurrency)
+    int maxDimension = 4001;        ///< upper clamp for requested sizes
+    std::size_t maxPendingOutput = 4 << 20; ///< unsent reply bytes after which a client's requests wait
+};
+
+/**
+ * @struct MazeServerStats
+ * @brief Counters since the server was created
+ */
+struct MazeServerStats
+{
+    std::uint64_t requests = 0;
+    std::uint64_t batches = 0;
+    std::uint64_t largestBatch = 0;
+    std::uint64_t generated = 0;    ///< cache misses (mazes generated and indexed)
+    std::uint64_t cacheHits = 0;    ///< requests served from a resident maze
+    std::uint64_t evictions = 0;
+};
+
+/**
+ * @struct MazeReply
+ * @brief Response header and payload for one request
+ */
+struct MazeReply
+{
+    MazeResponse header;
+    std::vector<std::uint8_t> payload;
+};
+
+/**
+ * @class MazeServer
+ * @brief Socket loop, batching and the resident maze cache
+ */
+class MazeServer
+{
+public:
+    /// largest maxDimension: cell indices are std::size_t, but depths are
+    /// std::int32_t per cell, so width * height must stay below 2^31
+    /// (odd, because Maze rounds an even bound up)
+    static const int MAX_DIMENSION = 46339;
+
+    /**
+     * @param options settings; maxDimension is clamped to MAX_DIMENSION
+     */
+    explicit MazeServer(const MazeServerOptions& options);
+    ~MazeServer();
+
+    MazeServer(const MazeServer&) = delete;
+    MazeServer& operator=(const MazeServer&) = delete;
+
+    /**
+     * @brief Bind and listen (a stale socket file is replaced)
+     * @return false if the socket cannot be created
+     */
+    bool start();
+
+    /**
+     * @brief Serve clients until stop becomes true (checked a few times per second)
+     */
+    void run(const std::atomic<bool>& stop);
+
+    /**
+     * @brief Answer one batch of requests
+     * @return one reply per request, in request order
+     */
+    std::vector<MazeReply> processBatch(const std::vector<MazeRequest>& requests);
+
+    MazeServerStats getStats() const { return m_stats; }
+    std::size_t getResidentCount() const { return m_cache.size(); }
+
+private:
+    /**
+     * Identity of a resident maze
+     */
+    struct CacheKey
+    {
+        std::uint32_t seed;
+        std::int32_t width, height;
+        std::uint8_t generator;
+
+        bool operator<(const CacheKey& other) const;
+    };
+
+    /**
+     * A resident maze and its index (built by the first batch that uses it)
+     */
+    struct CacheEntry
+    {
+        std::unique_ptr<Maze> maze;
+        std::vector<std::uint8_t> parentDirection;  // MazeDirection towards the start, per cell
+        std::vector<std::int32_t> depth;            // distance from the start, -1 = unreachable (see MAX_DIMENSION)
+        std::uint64_t lastUsed = 0;
+        std::int64_t openCells = 0;
+    };
+
+    MazeServerOptions m_options;
+    int m_listenFd;
+    std::map<CacheKey, CacheEntry> m_cache;
+    std::uint64_t m_clock;          // batch counter for LRU order
+    MazeServerStats m_stats;
+
+    /**
+     * @brief Generate and index the entry's maze if that has not happened yet
+     */
+    void prepare(const CacheKey& key, CacheEntry& entry, unsigned generatorThreads);
+
+    /**
+     * @brief Answer one validated request against its (prepared) maze
+     */
+    void answer(CacheEntry& entry, const MazeRequest& request, MazeReply& reply);
+
+    /**
+     * @brief Drop least recently used mazes beyond the cache size
+     */
+    void evict();
+};
+
+#endif // MAZE_SERVER_H
@@ -0,0 +1,87 @@
+/**
+ * @file Neighborhood.h
+ * @brief Compile-time movement models for the grid solvers
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * A neighborhood is a type listing its moves as a constexpr table of
+ * CellDirection values. Solvers take it as a template parameter and call
+ * forEachNeighbor, which expands the table into one straight-line probe
+ * per move: no loop, no runtime offset arrays, and no bounds checks.
+ * Solvers only step out of open cells, and the maze border is always
+ * wall, so every probed index is inside the grid.
+ *
+ * Diagonal moves may cut the corner past one wall, but not squeeze
+ * between two: NE is allowed when N or E is open. Every move costs one
+ * step, so BFS finds the fewest moves.
+ *
+ * Another grid (e.g. hex) would be one more type with its own table and
+ * direction numbering in Maze::neighborIndex.
+ */
+
+#ifndef NEIGHBORHOOD_H
+#define NEIGHBORHOOD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "MazeGenerator.h"
+
+/**
+ * @struct FourConnected
+ * @brief Orthogonal moves only (the default everywhere)
+ */
+struct FourConnected
+{
+    static constexpr int SIZE = 4;
+    static constexpr std::uint8_t MOVES[SIZE] = {DIR_NORTH, DIR_EAST, DIR_SOUTH, DIR_WEST};
+    static constexpr const char* NAME = "4-way";
+};
+
+/**
+ * @struct EightConnected
+ * @brief Orthogonal and diagonal moves
+ */
+struct EightConnected
+{
+    static constexpr int SIZE = 8;
+    static constexpr std::uint8_t MOVES[SIZE] = {DIR_NORTH, DIR_NORTHEAST, DIR_EAST, DIR_SOUTHEAST,
+                                                 DIR_SOUTH, DIR_SOUTHWEST, DIR_WEST, DIR_NORTHWEST};
+    static constexpr const char* NAME = "8-way";
+};
+
+namespace neighborhood_detail
+{
+    template <int D, typename Visit>
+    inline void probe(const Maze& maze, std::size_t cell, Visit& visit)
+    {
+        if constexpr (D > DIR_WEST)
+        {
+            // diagonal: at least one of the two orthogonal cells must be open
+            if (!maze.isOpen(maze.neighborIndex(cell, verticalPart(D))) &&
+                !maze.isOpen(maze.neighborIndex(cell, horizontalPart(D))))
+            {
+                return;
+            }
+        }
+        visit(maze.neighborIndex(cell, D), D);
+    }
+
+    template <typename Neighborhood, typename Visit, std::size_t... K>
+    inline void unroll(const Maze& maze, std::size_t cell, Visit& visit, std::index_sequence<K...>)
+    {
+        (probe<Neighborhood::MOVES[K]>(maze, cell, visit), ...);
+    }
+}
+
+/**
+ * @brief Calls visit(neighborIndex, direction) for every move of the
+ * neighborhood from cell, in table order. cell must be an open cell
+ * (or at least not on the border); the neighbor may be a wall.
+ */
+template <typename Neighborhood, typename Visit>
+inline void forEachNeighbor(const Maze& maze, std::size_t cell, Visit&& visit)
+{
+    neighborhood_detail::unroll<Neighborhood>(maze, cell, visit, std::make_index_sequence<Neighborhood::SIZE>());
+}
+
+#endif // NEIGHBORHOOD_H
@@ -0,0 +1,82 @@
+/**
+ * @file PathCache.cpp
+ * @brief Small cache of solver results for unchanged mazes
+ * @course ECE 4122/6122 - Homework 1
+ */
+
+#include "PathCache.h"
+
+const CachedPath* PathCache::find(const Maze& maze, Position start, Position end, CachedSolver solver)
+{
+    const std::uint64_t generation = maze.getGeneration();
+    for (Entry& entry : m_entries)
+    {
+        if (entry.generation == generation && entry.solver == solver && entry.start == start && entry.end == end)
+        {
+            entry.lastUsed = ++m_clock;
+            m_hits++;
+            return &entry.result;
+        }
+    }
+    m_misses++;
+    return nullptr;
+}
+
+bool PathCache::store(const Maze& maze, Position start, Position end, CachedSolver solver,
+                      const std::vector<Position>& path, int nodes)
+{
+    CachedPath result;
+    if (!result.path.assign(path))
+    {
+        return false;
+    }
+    result.nodes = nodes;
+
+    const std::uint64_t generation = maze.getGeneration();
+    Entry* slot = nullptr;
+    for (Entry& entry : m_entries)
+    {
+        if (entry.generation == generation && entry.solver == solver && entry.start == start && entry.end == end)
+        {
+            slot = &entry; // same query solved again: overwrite
+            break;
+        }
+    }
+    if (!slot && m_entries.size() < m_capacity)
+    {
+        m_entries.push_back(Entry());
+        slot = &m_entries.back();
+    }
+    if (!slot)
+    {
+        // entries of older mazes go first, then the least recently used
+        slot = &m_entries.front();
+        for (Entry& entry : m_entries)
+        {
+            bool stale = entry.generation != generation;
+            bool slotStale = slot->generation != generation;
+            if ((stale && !slotStale) || (stale == slotStale && entry.lastUsed < slot->lastUsed))
+            {
+                slot = &entry;
+            }
+        }
+    }
+
+    slot->generation = generation;
+    slot->start = start;
+    slot->end = end;
+    slot->solver = solver;
+    slot->lastUsed = ++m_clock;
+    slot->result = std::move(result);
+    return true;
+}
+
+std::size_t PathCache::getMemoryBytes() const
+{
+    std::size_t total = 0;
+    for (const Entry& entry : m_entries)
+    {
+        total += entry.result.path.getMemoryBytes();
+    }
+    return total;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file PathCache.h
+ * @brief Small cache of solver results for unchanged mazes
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * Results are keyed by (maze generation, start, end, solver) and stored
+ * as CompactPath. Maze::getGeneration() changes on every generate() and
+ * on every edit that opens or closes a cell, and no two mazes share a
+ * generation, so entries for an old maze can never match again. They
+ * are not searched for: stale entries are simply the first to be
+ * replaced. Only 4-connected results can be stored.
+ */
+
+#ifndef PATH_CACHE_H
+#define PATH_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "CompactPath.h"
+
+/**
+ * @enum CachedSolver
+ * @brief Solver part of a PathCache key
+ */
+enum class CachedSolver : std::uint8_t
+{
+    BFS,
+    DeadEndFill,
+    Hierarchical
+};
+
+/**
+ * @struct CachedPath
+ * @brief One cached result
+ */
+struct CachedPath
+{
+    CompactPath path;       ///< empty if the solver found no path
+    int nodes = 0;          ///< nodes explored by the original solve
+};
+
+/**
+ * @class PathCache
+ * @brief Fixed number of results, least recently used replaced first
+ */
+class PathCache
+{
+public:
+    explicit PathCache(std::size_t capacity = 8) : m_capacity(capacity > 0 ? capacity : 1), m_clock(0) {}
+
+    /**
+     * @brief Cached result for this query on the maze as it is now
+     * @return nullptr on a miss; otherwise valid until the next store()
+     */
+    const CachedPath* find(const Maze& maze, Position start, Position end, CachedSolver solver);
+
+    /**
+     * @brief Remember a result for this query on the maze as it is now
+     * @return false if the path has diagonal moves and was not stored
+     */
+    bool store(const Maze& maze, Position start, Position end, CachedSolver solver,
+               const std::vector<Position>& path, int nodes);
+
+    std::size_t getHits() const { return m_hits; }
+    std::size_t getMisses() const { return m_misses; }
+
+    /**
+     * @brief Bytes held by the cached paths
+     */
+    std::size_t getMemoryBytes() const;
+
+private:
+    struct Entry
+    {
+        std::uint64_t generation;
+        Position start, end;
+        CachedSolver solver;
+        std::uint64_t lastUsed;
+        CachedPath result;
+    };
+
+    std::size_t m_capacity;
+    std::uint64_t m_clock;
+    std::size_t m_hits = 0, m_misses = 0;
+    std::vector<Entry> m_entries;
+};
+
+#endif // PATH_CACHE_H
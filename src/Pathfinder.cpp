@@ -19,8 +19,14 @@ to solve the maze using BFS and reconstruct shortest path.
  *    c. For each valid neighbor one unit away in cardinal directions:
  *       - if neighbor is in path/is an end, AND hasn't been visited,
  *       - mark neighbor as visited
- *       - record current cell as predecessor in cellMap
+ *       - record the direction back to the current cell
  *       - add neighbor to queue.
+ * Cells are visited by Maze cell index and neighborIndex, so the search
+ * follows whatever memory layout the maze uses (see CellLayout).
+ *
+ * The BFS and dead-end fill solvers are templates in Pathfinder.h
+ * (observer policy); this file holds their std::function adapters and
+ * path reconstruction.
  */
 
 #include "Pathfinder.h"
@@ -28,69 +34,41 @@ to solve the maze using BFS and reconstruct shortest path.
 
 std::vector<Position> solveBFS(Maze& goalMaze, std::function<void(bool)> renderer, float& delayTime, int& nodes)
 {
-    nodes = 0; //reset count
+    (void)delayTime; // the renderer owns the animation delay
+    VisualObserver observer{renderer};
+    return solveBFS(goalMaze, observer, nodes);
+}
 
-    //get start and end
-    Position start = {goalMaze.getStart().first, goalMaze.getStart().second};
-    Position end = {goalMaze.getEnd().first, goalMaze.getEnd().second};
-    
-    //setup FIFO queue
-    std::queue<Position> frontier;
-    std::unordered_map<Position, Position, PositionHash> cellMap; //current pos : prev pos, allows retracing
-    std::unordered_map<Position, bool, PositionHash> visited; //cells already traversed
-    
-    frontier.push(start);
-    visited[start] = true;
-    nodes ++;
-    cellMap[start] = {-1, -1};  // Sentinel value for start
-    
-    // Direction vectors: up, down, left, right
-    const int dr[] = {-1, 1, 0, 0}; // delta row
-    const int dc[] = {0, 0, -1, 1}; // delta column
-    
-    while (!frontier.empty()) //while queue not empty
+const std::vector<Position>& solveBFS(Maze& goalMaze, std::function<void(bool)> renderer, float& delayTime, int& nodes,
+                                      SolverWorkspace& workspace, bool diagonal)
+{
+    (void)delayTime; // the renderer owns the animation delay
+    VisualObserver observer{renderer};
+    if (diagonal)
     {
-        Position current = frontier.front(); // grab oldest item in queue (FIFO)
-        frontier.pop(); // remove it
-        
-        // Goal check
-        if (current == end) // if we're at the end, reconstruct
-        {
-            return reconstructPath(cellMap,end, goalMaze);
-        }
-        
-        //if we're here, we're not at the end
-        //at our current pos, let's explore neighbors
-        for (int i = 0; i < 4; ++i) 
-        {
-            Position next = {current.row + dr[i], current.col + dc[i]};
-            
-            if (goalMaze.isValidPath(next.row, next.col) && !visited[next]) 
-            // if the next row and column are valid paths and we havent visited yet
-            {
-                //lets mark next as visited and update queue
-                visited[next] = true;
-                nodes++;
-                cellMap[next] = current;
-                frontier.push(next);
-                
-                // Mark for visualization (optional)
-                if (goalMaze.getCell(next.row, next.col).type == CellType::Path) 
-                {
-                    goalMaze.setCellType(next.row, next.col, CellType::Visited);
-                }
-
-                if (renderer)
-                {
-                    renderer(true);
-                }
-            }
-        }
+        return solveBFS<EightConnected>(goalMaze, observer, nodes, workspace);
     }
-    return {};  // No path found
+    return solveBFS(goalMaze, observer, nodes, workspace);
+}
+
+std::vector<Position> solveDeadEndFill(Maze& goalMaze, std::function<void(bool)> renderer, float& delayTime, int& nodes)
+{
+    (void)delayTime; // the renderer owns the animation delay
+    VisualObserver observer{renderer};
+    return solveDeadEndFill(goalMaze, observer, nodes, 1); // renderer is not thread-safe
+}
+
+const std::vector<Position>& solveDeadEndFill(Maze& goalMaze, std::function<void(bool)> renderer, float& delayTime, int& nodes,
+                                              SolverWorkspace& workspace)
+{
+    (void)delayTime; // the renderer owns the animation delay
+    VisualObserver observer{renderer};
+    return solveDeadEndFill(goalMaze, observer, nodes, workspace, 1); // renderer is not thread-safe
 }
 
 std::vector<Position> reconstructPath(std::unordered_map<Position, Position, PositionHash>& cellMap, Position end, Maze& goalMaze) {
+            MAZE_PERF_PHASE("reconstructPath", static_cast<std::uint64_t>(goalMaze.getWidth()) * goalMaze.getHeight());
+            MAZE_TRACE_ZONE("reconstructPath");
             std::vector<Position> path;
             Position pos = end;
             while (!(pos.row == -1 && pos.col == -1)) //loop backwards until we hit the start @ {-1. -1}
@@ -110,4 +88,40 @@ std::vector<Position> reconstructPath(std::unordered_map<Position, Position, Pos
             }
             std::reverse(path.begin(), path.end()); //BFS finds path backwards, reverse it!
             return path;
-}
\ No newline at end of file
+}
+
+const std::vector<Position>& reconstructPath(SolverWorkspace& workspace, std::size_t end, Maze& goalMaze)
+{
+    MAZE_PERF_PHASE("reconstructPath", static_cast<std::uint64_t>(goalMaze.getWidth()) * goalMaze.getHeight());
+    MAZE_TRACE_ZONE("reconstructPath");
+
+    //count the steps back to the start first
+    std::size_t length = 1;
+    for (std::size_t cell = end; workspace.getParentDirection(cell) != SolverWorkspace::ROOT; ++length)
+    {
+        cell = goalMaze.neighborIndex(cell, workspace.getParentDirection(cell));
+    }
+
+    //then fill the path from its end, no reverse needed
+    std::vector<Position>& path = workspace.path;
+    path.resize(length);
+    std::size_t cell = end;
+    for (std::size_t i = length; i-- > 0;)
+    {
+        std::pair<int, int> pos = goalMaze.cellPosition(cell);
+        path[i] = {pos.first, pos.second};
+
+        // if not start/end, then its in the solution
+        CellType type = goalMaze.getCell(pos.first, pos.second).type;
+        if (type != CellType::Start && type != CellType::End)
+        {
+            goalMaze.setCellType(pos.first, pos.second, CellType::Solution);
+        }
+        // move to previous cell in the reconstructed trail
+        if (i > 0)
+        {
+            cell = goalMaze.neighborIndex(cell, workspace.getParentDirection(cell));
+        }
+    }
+    return path;
+}
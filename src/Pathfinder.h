@@ -24,8 +24,17 @@ functions to solve the maze and reconstruct shortest path.
 #include <vector> //List
 #include <queue> //Queue
 #include <unordered_map> //Map
+#include <algorithm> //reverse
 #include "MazeGenerator.h" // Maze def
+#include "PerfCounters.h" // opt-in phase instrumentation
+#include "Trace.h" // opt-in trace zones
 #include <functional> //so we can do the renderer thing
+#include <atomic> //dead-end fill degree counters
+#include <thread> //dead-end fill stripes
+#include <cstdint>
+#include <memory>
+#include "SolverArena.h" // per-solve scratch
+#include "Neighborhood.h" // movement models
 
 
 //types
@@ -52,10 +61,178 @@ struct PositionHash {
     }
 };
 
+//observers
+// Solvers are templated on an observer policy that is told about every
+// newly discovered cell. The hook is a plain inline call, so the empty
+// NullObserver compiles away entirely and headless solves pay nothing.
+
+/**
+ * @struct NullObserver
+ * @brief Observer that ignores every event (headless / benchmark solves).
+ * Cells are not marked as Visited; only the final Solution is written.
+ */
+struct NullObserver {
+    void onDiscover(Maze&, const Position&) {}
+};
+
+/**
+ * @struct CountingObserver
+ * @brief Observer that only counts discovered cells.
+ */
+struct CountingObserver {
+    long long discovered = 0;
+
+    void onDiscover(Maze&, const Position&) { ++discovered; }
+};
+
+/**
+ * @struct VisualObserver
+ * @brief Observer that marks discovered cells as Visited and calls the
+ * SFML renderer, i.e. the original solveBFS visualization behaviour.
+ */
+struct VisualObserver {
+    std::function<void(bool)> renderer; // may be empty: mark cells only
+
+    void onDiscover(Maze& goalMaze, const Position& pos) {
+        // don't paint over the End marker
+        if (goalMaze.getCell(pos.row, pos.col).type == CellType::Path)
+        {
+            goalMaze.setCellType(pos.row, pos.col, CellType::Visited);
+        }
+        if (renderer)
+        {
+            renderer(true);
+        }
+    }
+};
+
+//workspace
+
+/**
+ * @class SolverWorkspace
+ * @brief Buffers kept between solves, so repeated solves stop allocating.
+ *
+ * Visited marks and parent directions share one byte per cell: the
+ * direction in the low bits, the solve's epoch in the high bits. A cell
+ * is visited only if its epoch is the current one, so begin() clears
+ * every mark by bumping the epoch and touches the array only once every
+ * MAX_EPOCH solves: 15, since the four direction bits (eight moves plus
+ * ROOT) leave four for epochs 1..15. Per-cell buffers grow to the
+ * largest maze seen.
+ * Variable-size scratch (the BFS queue) comes from a SolverArena that
+ * begin() rewinds. The solution is written to path, whose capacity is
+ * kept as well.
+ *
+ * Not thread-safe: one workspace per concurrently solving thread.
+ */
+class SolverWorkspace {
+public:
+    static const int ROOT = 8; ///< parent direction stored for the start cell
+
+    std::vector<Position> path; ///< result of the last solve
+
+    /**
+     * @brief Start a solve of goalMaze: clears marks, rewinds the arena.
+     */
+    void begin(const Maze& goalMaze)
+    {
+        std::size_t slots = goalMaze.getCellSlots();
+        if (m_marks.size() < slots)
+        {
+            m_marks.assign(slots, 0);
+            m_epoch = 0;
+        }
+        if (++m_epoch > MAX_EPOCH)
+        {
+            std::fill(m_marks.begin(), m_marks.end(), std::uint8_t(0));
+            m_epoch = 1;
+        }
+        m_arena.reset();
+        path.clear();
+    }
+
+    bool isVisited(std::size_t cell) const { return (m_marks[cell] >> DIRECTION_BITS) == m_epoch; }
+    void visit(std::size_t cell, int parentDirection) {
+        m_marks[cell] = static_cast<std::uint8_t>((m_epoch << DIRECTION_BITS) | parentDirection);
+    }
+    int getParentDirection(std::size_t cell) const { return m_marks[cell] & ((1 << DIRECTION_BITS) - 1); }
+
+    /**
+     * @brief Dead-end fill counters for at least slots cells (contents
+     * are left over from earlier solves, the solver rewrites them)
+     */
+    std::atomic<std::uint8_t>* getDegrees(std::size_t slots)
+    {
+        if (m_degreeSlots < slots)
+        {
+            m_degrees.reset(new std::atomic<std::uint8_t>[slots]());
+            m_degreeSlots = slots;
+        }
+        return m_degrees.get();
+    }
+
+    /**
+     * @brief threads empty work lists (their capacity is kept)
+     */
+    std::vector<std::vector<std::size_t>>& getWorkLists(unsigned threads)
+    {
+        if (m_work.size() < threads)
+        {
+            m_work.resize(threads);
+        }
+        for (std::vector<std::size_t>& list : m_work)
+        {
+            list.clear();
+        }
+        return m_work;
+    }
+
+    SolverArena& getArena() { return m_arena; }
+
+    /// queue capacity the last BFS ended with, a good start for the next
+    std::size_t queueHint = 0;
+
+private:
+    static const int DIRECTION_BITS = 4; // CellDirection (diagonals too) or ROOT
+    static const std::uint8_t MAX_EPOCH = 0xFF >> DIRECTION_BITS; // full wipe every 15 solves
+
+    std::vector<std::uint8_t> m_marks;
+    std::uint8_t m_epoch = 0;
+    std::unique_ptr<std::atomic<std::uint8_t>[]> m_degrees;
+    std::size_t m_degreeSlots = 0;
+    std::vector<std::vector<std::size_t>> m_work;
+    SolverArena m_arena;
+};
+
 //functions
 
 /**
  * @brief Finds the shortest path from start to end using BFS.
+ * @tparam Neighborhood movement model (FourConnected, EightConnected),
+ *         e.g. solveBFS<EightConnected>(maze, observer, nodes).
+ * @tparam Observer policy with onDiscover(Maze&, const Position&).
+ * @param goalMaze reference to a maze object to solve.
+ * @param observer observer notified of every discovered cell.
+ * @param nodes number of nodes explored
+ * @return A vector of Position structs representing the path.
+ */
+template <typename Neighborhood = FourConnected, typename Observer>
+std::vector<Position> solveBFS(Maze& goalMaze, Observer& observer, int& nodes);
+
+/**
+ * @brief Finds the shortest path using (and reusing) a workspace. Once
+ * the workspace has seen a maze this size, the solve does no heap
+ * allocation.
+ * @return workspace.path, valid until the workspace's next solve.
+ */
+template <typename Neighborhood = FourConnected, typename Observer>
+const std::vector<Position>& solveBFS(Maze& goalMaze, Observer& observer, int& nodes, SolverWorkspace& workspace);
+
+/**
+ * @brief Finds the shortest path from start to end using BFS.
+ * Adapter over the templated solver using a VisualObserver. The
+ * workspace overload reuses its buffers and can allow diagonal moves
+ * (EightConnected).
  * @param goalMaze reference to a maze object to solve.
  * @param renderer function from main which handles SFML rendering.
  * @param delayTime chosen delay time for animation.
@@ -63,6 +240,55 @@ struct PositionHash {
  * @return A vector of Position structs representing the path.
  */
 std::vector<Position> solveBFS(Maze& goalMaze, std::function<void(bool)> renderer, float& delayTime, int& nodes);
+const std::vector<Position>& solveBFS(Maze& goalMaze, std::function<void(bool)> renderer, float& delayTime, int& nodes,
+                                      SolverWorkspace& workspace, bool diagonal = false);
+
+/**
+ * @brief Solves a perfect maze by dead-end filling.
+ *
+ * Every open cell with a single open neighbour (other than start/end) is
+ * a dead end; filling it can turn its neighbour into a new dead end. The
+ * fill works from per-thread work lists with no queue ordering and no
+ * hashing, so the grid is split into row stripes that are processed in
+ * parallel. When nothing is left to fill, the remaining open cells are
+ * the start-to-end corridor, which is walked and marked as Solution the
+ * same way reconstructPath does.
+ *
+ * Mazes with loops keep their loops after filling; the solver then falls
+ * back to solveBFS on the same maze.
+ * @tparam Observer policy with onDiscover(Maze&, const Position&), told
+ *         about every filled cell. With threads != 1 it is called from
+ *         the worker threads and must be thread-safe (NullObserver is).
+ * @param goalMaze reference to a maze object to solve.
+ * @param observer observer notified of every filled cell.
+ * @param nodes number of cells filled plus corridor cells walked
+ * @param threads row stripes filled in parallel, 0 = hardware concurrency
+ * @return A vector of Position structs representing the path.
+ */
+template <typename Observer>
+std::vector<Position> solveDeadEndFill(Maze& goalMaze, Observer& observer, int& nodes, unsigned threads = 1);
+
+/**
+ * @brief Dead-end filling using (and reusing) a workspace.
+ * @return workspace.path, valid until the workspace's next solve.
+ */
+template <typename Observer>
+const std::vector<Position>& solveDeadEndFill(Maze& goalMaze, Observer& observer, int& nodes, SolverWorkspace& workspace,
+                                              unsigned threads = 1);
+
+/**
+ * @brief Solves the maze by dead-end filling (single thread).
+ * Adapter over the templated solver using a VisualObserver: filled
+ * cells are shown as Visited.
+ * @param goalMaze reference to a maze object to solve.
+ * @param renderer function from main which handles SFML rendering.
+ * @param delayTime chosen delay time for animation.
+ * @param nodes number of cells filled plus corridor cells walked
+ * @return A vector of Position structs representing the path.
+ */
+std::vector<Position> solveDeadEndFill(Maze& goalMaze, std::function<void(bool)> renderer, float& delayTime, int& nodes);
+const std::vector<Position>& solveDeadEndFill(Maze& goalMaze, std::function<void(bool)> renderer, float& delayTime, int& nodes,
+                                              SolverWorkspace& workspace);
 
 /**
  * @brief Traces end to start using a map of all cells traversed.
@@ -73,4 +299,248 @@ std::vector<Position> solveBFS(Maze& goalMaze, std::function<void(bool)> rendere
  */
 std::vector<Position> reconstructPath(std::unordered_map<Position, Position, PositionHash>& cellMap, Position end, Maze& goalMaze);
 
+/**
+ * @brief Traces end to start through the parent directions of a BFS.
+ * Counts the steps first, then fills workspace.path back to front, so
+ * neither growing nor reversing is needed.
+ * @param workspace workspace of the BFS that reached end.
+ * @param end cell index (Maze::cellIndex) to begin traceback from.
+ * @param goalMaze reference to the maze object to solve.
+ * @return workspace.path in ORDER from start pos to end.
+ */
+const std::vector<Position>& reconstructPath(SolverWorkspace& workspace, std::size_t end, Maze& goalMaze);
+
+//template implementations (must be visible to every caller)
+
+template <typename Neighborhood, typename Observer>
+std::vector<Position> solveBFS(Maze& goalMaze, Observer& observer, int& nodes)
+{
+    SolverWorkspace workspace; // one-off: pays for its buffers every call
+    solveBFS<Neighborhood>(goalMaze, observer, nodes, workspace);
+    return std::move(workspace.path);
+}
+
+template <typename Neighborhood, typename Observer>
+const std::vector<Position>& solveBFS(Maze& goalMaze, Observer& observer, int& nodes, SolverWorkspace& workspace)
+{
+    MAZE_PERF_PHASE("solveBFS", static_cast<std::uint64_t>(goalMaze.getWidth()) * goalMaze.getHeight());
+    MAZE_TRACE_ZONE("solveBFS");
+
+    nodes = 0; //reset count
+    workspace.begin(goalMaze); //clears visited marks, path and scratch
+
+    //get start and end (as cell indices, so the maze's layout decides locality)
+    const std::size_t start = goalMaze.cellIndex(goalMaze.getStart().first, goalMaze.getStart().second);
+    const std::size_t end = goalMaze.cellIndex(goalMaze.getEnd().first, goalMaze.getEnd().second);
+    
+    //setup FIFO queue (in the workspace arena); the visited marks also
+    //hold the direction back to the previous cell, allows retracing
+    ArenaQueue<std::size_t> frontier(workspace.getArena(),
+                                     std::max<std::size_t>(workspace.queueHint, goalMaze.getWidth() + goalMaze.getHeight()));
+    
+    frontier.push(start);
+    workspace.visit(start, SolverWorkspace::ROOT);
+    nodes ++;
+    
+    while (!frontier.empty()) //while queue not empty
+    {
+        std::size_t current = frontier.pop(); // grab oldest item in queue (FIFO) and remove it
+        
+        // Goal check
+        if (current == end) // if we're at the end, reconstruct
+        {
+            workspace.queueHint = frontier.capacity();
+            return reconstructPath(workspace, end, goalMaze);
+        }
+        
+        //if we're here, we're not at the end
+        //at our current pos, let's explore neighbors (unrolled per neighborhood;
+        //open cells never sit on the border, so no bounds checks)
+        forEachNeighbor<Neighborhood>(goalMaze, current, [&](std::size_t next, int d) {
+            if (!workspace.isVisited(next) && goalMaze.isOpen(next)) 
+            // if next is a valid path and we havent visited yet
+            {
+                //lets mark next as visited and update queue
+                workspace.visit(next, oppositeDirection(d));
+                nodes++;
+                frontier.push(next);
+                
+                // visualization/statistics hook (no-op for NullObserver)
+                std::pair<int, int> pos = goalMaze.cellPosition(next);
+                observer.onDiscover(goalMaze, Position{pos.first, pos.second});
+            }
+        });
+    }
+    workspace.queueHint = frontier.capacity();
+    return workspace.path;  // No path found (empty)
+}
+
+template <typename Observer>
+std::vector<Position> solveDeadEndFill(Maze& goalMaze, Observer& observer, int& nodes, unsigned threads)
+{
+    SolverWorkspace workspace; // one-off: pays for its buffers every call
+    solveDeadEndFill(goalMaze, observer, nodes, workspace, threads);
+    return std::move(workspace.path);
+}
+
+template <typename Observer>
+const std::vector<Position>& solveDeadEndFill(Maze& goalMaze, Observer& observer, int& nodes, SolverWorkspace& workspace,
+                                              unsigned threads)
+{
+    MAZE_PERF_PHASE("solveDeadEndFill", static_cast<std::uint64_t>(goalMaze.getWidth()) * goalMaze.getHeight());
+    MAZE_TRACE_ZONE("solveDeadEndFill");
+
+    nodes = 0; //reset count
+
+    const int width = goalMaze.getWidth();
+    const int height = goalMaze.getHeight();
+    const std::size_t startCell = goalMaze.cellIndex(goalMaze.getStart().first, goalMaze.getStart().second);
+    const std::size_t endCell = goalMaze.cellIndex(goalMaze.getEnd().first, goalMaze.getEnd().second);
+    auto positionOf = [&](std::size_t cell) {
+        std::pair<int, int> pos = goalMaze.cellPosition(cell);
+        return Position{pos.first, pos.second};
+    };
+
+    workspace.begin(goalMaze);
+
+    // open, unfilled neighbours per cell; 0 = wall or already filled.
+    // Decrements never go below zero (CAS), so a cell is pushed exactly
+    // once: by whichever thread takes it from 2 down to 1.
+    std::atomic<std::uint8_t>* degree = workspace.getDegrees(goalMaze.getCellSlots());
+
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::max(1u, std::min(threads, static_cast<unsigned>(height)));
+    MAZE_PERF_WORKERS(threads);
+    const int stripeRows = (height + static_cast<int>(threads) - 1) / static_cast<int>(threads);
+
+    std::vector<std::vector<std::size_t>>& work = workspace.getWorkLists(threads); // per-thread LIFO work lists
+    int* filled = workspace.getArena().allocate<int>(threads);
+    std::fill_n(filled, threads, 0);
+
+    // runs one phase over every stripe; the calling thread takes the first
+    auto forEachStripe = [&](auto&& phase) {
+        std::vector<std::thread> workers;
+        for (unsigned t = 1; t < threads; ++t)
+        {
+            workers.emplace_back(phase, t);
+        }
+        phase(0u);
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+    };
+
+    // pass 1: degrees, and the initial dead ends of each stripe
+    forEachStripe([&](unsigned t) {
+        MAZE_TRACE_ZONE("deadEndDegrees");
+        int firstRow = static_cast<int>(t) * stripeRows;
+        int lastRow = std::min(height, firstRow + stripeRows);
+        for (int row = firstRow; row < lastRow; ++row)
+        {
+            for (int col = 0; col < width; ++col)
+            {
+                std::size_t cell = goalMaze.cellIndex(row, col);
+                std::uint8_t open = 0;
+                if (goalMaze.isOpen(cell))
+                {
+                    forEachNeighbor<FourConnected>(goalMaze, cell, [&](std::size_t next, int) {
+                        open += goalMaze.isOpen(next) ? 1 : 0;
+                    });
+                    if (open == 1 && cell != startCell && cell != endCell)
+                    {
+                        work[t].push_back(cell);
+                    }
+                }
+                degree[cell].store(open, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    // pass 2: fill dead ends until none are left. A filled cell's
+    // neighbour may lie in another stripe; it is simply followed by the
+    // thread that filled into it.
+    forEachStripe([&](unsigned t) {
+        MAZE_TRACE_ZONE("deadEndFill");
+        std::vector<std::size_t>& stack = work[t];
+        while (!stack.empty())
+        {
+            std::size_t cell = stack.back();
+            stack.pop_back();
+            degree[cell].store(0, std::memory_order_release);
+            filled[t]++;
+            observer.onDiscover(goalMaze, positionOf(cell));
+
+            forEachNeighbor<FourConnected>(goalMaze, cell, [&](std::size_t next, int) {
+                std::uint8_t open = degree[next].load(std::memory_order_acquire);
+                while (open > 0 && !degree[next].compare_exchange_weak(open, open - 1, std::memory_order_acq_rel))
+                {
+                }
+                if (open == 2 && next != startCell && next != endCell)
+                {
+                    stack.push_back(next); // next just became a dead end
+                }
+            });
+        }
+    });
+
+    for (unsigned t = 0; t < threads; ++t)
+    {
+        nodes += filled[t];
+    }
+
+    // walk the corridor that is left from start to end
+    std::vector<Position>& path = workspace.path;
+    std::size_t cell = startCell, previous = startCell;
+    while (true)
+    {
+        path.push_back(positionOf(cell));
+        nodes++;
+        if (cell == endCell)
+        {
+            break;
+        }
+
+        std::size_t next = cell;
+        int choices = 0;
+        forEachNeighbor<FourConnected>(goalMaze, cell, [&](std::size_t candidate, int) {
+            if (candidate != previous && degree[candidate].load(std::memory_order_relaxed) > 0)
+            {
+                next = candidate;
+                choices++;
+            }
+        });
+        if (choices == 0)
+        {
+            path.clear();
+            return path; // No path found
+        }
+        if (choices > 1)
+        {
+            // a loop survived the fill: not a perfect maze
+            NullObserver fallback;
+            int bfsNodes = 0;
+            solveBFS(goalMaze, fallback, bfsNodes, workspace);
+            nodes += bfsNodes;
+            return workspace.path;
+        }
+        previous = cell;
+        cell = next;
+    }
+
+    // same marking as reconstructPath
+    for (const Position& pos : path)
+    {
+        CellType type = goalMaze.getCell(pos.row, pos.col).type;
+        if (type != CellType::Start && type != CellType::End)
+        {
+            goalMaze.setCellType(pos.row, pos.col, CellType::Solution);
+        }
+    }
+    return path;
+}
+
 #endif
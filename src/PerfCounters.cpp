@@ -0,0 +1,306 @@
+/**
+ * @file PerfCounters.cpp
+ * @brief Implementation of the perf_event_open based phase profiler
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * Each thread opens one counter per PerfEvent for itself (pid 0, any CPU),
+ * user space only so it works with the default perf_event_paranoid level.
+ * A phase reads all counters on entry and exit and records the difference.
+ * On non-Linux systems every event reports as unavailable and only wall
+ * time is recorded.
+ */
+
+#include "PerfCounters.h"
+#include <cstdio>
+#include <sstream>
+#include <iomanip>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    const char* EVENT_NAMES[PERF_EVENT_COUNT] = {"cycles", "instr", "L1D-miss", "LLC-miss", "br-miss"};
+
+    /**
+     * Per-thread set of counter file descriptors (-1 = unavailable).
+     */
+    struct ThreadCounters
+    {
+        int fds[PERF_EVENT_COUNT];
+
+        ThreadCounters()
+        {
+            for (int i = 0; i < PERF_EVENT_COUNT; ++i)
+            {
+                fds[i] = -1;
+            }
+#if defined(__linux__)
+            const std::uint32_t types[PERF_EVENT_COUNT] = {
+                PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE,
+                PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE};
+            const std::uint64_t configs[PERF_EVENT_COUNT] = {
+                PERF_COUNT_HW_CPU_CYCLES,
+                PERF_COUNT_HW_INSTRUCTIONS,
+                PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+                PERF_COUNT_HW_CACHE_MISSES,
+                PERF_COUNT_HW_BRANCH_MISSES};
+
+            for (int i = 0; i < PERF_EVENT_COUNT; ++i)
+            {
+                perf_event_attr attr = {};
+                attr.size = sizeof(attr);
+                attr.type = types[i];
+                attr.config = configs[i];
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+                if (fds[i] >= 0)
+                {
+                    ioctl(fds[i], PERF_EVENT_IOC_RESET, 0);
+                    ioctl(fds[i], PERF_EVENT_IOC_ENABLE, 0);
+                }
+            }
+#endif
+        }
+
+        ~ThreadCounters()
+        {
+#if defined(__linux__)
+            for (int fd : fds)
+            {
+                if (fd >= 0)
+                {
+                    close(fd);
+                }
+            }
+#endif
+        }
+    };
+
+    ThreadCounters& threadCounters()
+    {
+        thread_local ThreadCounters counters;
+        return counters;
+    }
+
+    thread_local PerfPhase* t_innermost = nullptr; // active phase on this thread
+
+    void addSample(PerfSample& into, const PerfSample& delta)
+    {
+        for (int i = 0; i < PERF_EVENT_COUNT; ++i)
+        {
+            into.values[i] += delta.values[i];
+        }
+        into.seconds += delta.seconds;
+    }
+
+    PhaseStats& findOrAdd(std::vector<PhaseStats>& phases, const char* name)
+    {
+        for (PhaseStats& phase : phases)
+        {
+            if (phase.name == name)
+            {
+                return phase;
+            }
+        }
+        phases.push_back(PhaseStats());
+        phases.back().name = name;
+        return phases.back();
+    }
+}
+
+PerfProfiler& PerfProfiler::instance()
+{
+    static PerfProfiler profiler;
+    return profiler;
+}
+
+bool PerfProfiler::isEventAvailable(PerfEvent event) const
+{
+    return threadCounters().fds[event] >= 0;
+}
+
+PerfSample PerfProfiler::read() const
+{
+    PerfSample sample;
+#if defined(__linux__)
+    ThreadCounters& counters = threadCounters();
+    for (int i = 0; i < PERF_EVENT_COUNT; ++i)
+    {
+        std::uint64_t value = 0;
+        if (counters.fds[i] >= 0 && ::read(counters.fds[i], &value, sizeof(value)) == sizeof(value))
+        {
+            sample.values[i] = value;
+        }
+    }
+#endif
+    return sample;
+}
+
+void PerfProfiler::record(const char* phase, const PerfSample& delta, std::uint64_t cells, bool callingThreadOnly,
+                          bool outermost)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    PhaseStats& total = findOrAdd(m_phases, phase);
+    total.calls++;
+    total.cells += cells;
+    total.callingThreadOnly = total.callingThreadOnly || callingThreadOnly;
+    addSample(total.total, delta);
+
+    PhaseStats& last = findOrAdd(m_last, phase);
+    last.calls = 1;
+    last.cells = cells;
+    last.callingThreadOnly = callingThreadOnly;
+    last.total = delta;
+
+    if (outermost)
+    {
+        m_lastOuter = phase;
+    }
+}
+
+void PerfProfiler::reset()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_phases.clear();
+    m_last.clear();
+    m_lastOuter.clear();
+}
+
+std::string PerfProfiler::getLastPhase() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lastOuter;
+}
+
+std::vector<PhaseStats> PerfProfiler::getPhases() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_phases;
+}
+
+std::string PerfProfiler::formatReport() const
+{
+    std::vector<PhaseStats> phases = getPhases();
+    std::ostringstream out;
+    out << std::left << std::setw(18) << "phase" << std::right << std::setw(8) << "calls" << std::setw(12) << "ms/call";
+    for (int i = 0; i < PERF_EVENT_COUNT; ++i)
+    {
+        out << std::setw(14) << (std::string(EVENT_NAMES[i]) + "/cell");
+    }
+    out << std::setw(8) << "IPC" << "\n";
+
+    out << std::fixed;
+    bool anyPartial = false;
+    for (const PhaseStats& phase : phases)
+    {
+        double cells = phase.cells > 0 ? static_cast<double>(phase.cells) : 1.0;
+        anyPartial = anyPartial || phase.callingThreadOnly;
+        out << std::left << std::setw(18) << (phase.callingThreadOnly ? phase.name + " *" : phase.name) << std::right << std::setw(8) << phase.calls
+            << std::setw(12) << std::setprecision(3) << (phase.total.seconds * 1000.0 / phase.calls);
+        for (int i = 0; i < PERF_EVENT_COUNT; ++i)
+        {
+            if (isEventAvailable(static_cast<PerfEvent>(i)))
+            {
+                out << std::setw(14) << std::setprecision(3) << (phase.total.values[i] / cells);
+            }
+            else
+            {
+                out << std::setw(14) << "n/a";
+            }
+        }
+        if (isEventAvailable(PERF_CYCLES) && isEventAvailable(PERF_INSTRUCTIONS) && phase.total.values[PERF_CYCLES] > 0)
+        {
+            out << std::setw(8) << std::setprecision(2)
+                << static_cast<double>(phase.total.values[PERF_INSTRUCTIONS]) / phase.total.values[PERF_CYCLES];
+        }
+        else
+        {
+            out << std::setw(8) << "n/a";
+        }
+        out << "\n";
+    }
+    if (anyPartial)
+    {
+        // time is wall clock for the whole phase; counters are per thread
+        out << "* ran on several threads: counters cover the calling thread only, per-cell figures are undercounted\n";
+    }
+    return out.str();
+}
+
+std::string PerfProfiler::formatHudLine(const std::string& phase) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const PhaseStats& last : m_last)
+    {
+        if (last.name != phase)
+        {
+            continue;
+        }
+        double cells = last.cells > 0 ? static_cast<double>(last.cells) : 1.0;
+        const std::uint64_t* v = last.total.values;
+        char line[160];
+        if (v[PERF_CYCLES] == 0)
+        {
+            // counters unavailable, wall time only
+            std::snprintf(line, sizeof(line), "%s: %.2fMS (NO HW COUNTERS)", phase.c_str(), last.total.seconds * 1000.0);
+        }
+        else
+        {
+            // counters saw only the calling thread of a multi-threaded phase
+            const char* partial = last.callingThreadOnly ? " (1 THREAD OF MANY)" : "";
+            std::snprintf(line, sizeof(line), "%s: %.0f CYC/CELL IPC %.2f LLC %.3f/CELL%s",
+                          phase.c_str(), v[PERF_CYCLES] / cells,
+                          static_cast<double>(v[PERF_INSTRUCTIONS]) / v[PERF_CYCLES], v[PERF_LLC_MISSES] / cells, partial);
+        }
+        return line;
+    }
+    return "";
+}
+
+PerfPhase::PerfPhase(const char* name, std::uint64_t cells)
+    : m_name(name), m_cells(cells), m_active(PerfProfiler::instance().isEnabled()), m_callingThreadOnly(false),
+      m_outer(t_innermost)
+{
+    if (m_active)
+    {
+        t_innermost = this;
+        m_start = PerfProfiler::instance().read();
+        m_startTime = std::chrono::steady_clock::now();
+    }
+}
+
+void PerfPhase::markWorkers(unsigned threads)
+{
+    if (threads <= 1)
+    {
+        return;
+    }
+    for (PerfPhase* phase = t_innermost; phase; phase = phase->m_outer)
+    {
+        phase->m_callingThreadOnly = true;
+    }
+}
+
+PerfPhase::~PerfPhase()
+{
+    if (!m_active)
+    {
+        return;
+    }
+    t_innermost = m_outer;
+    PerfSample end = PerfProfiler::instance().read();
+    PerfSample delta;
+    for (int i = 0; i < PERF_EVENT_COUNT; ++i)
+    {
+        delta.values[i] = end.values[i] - m_start.values[i];
+    }
+    delta.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_startTime).count();
+    PerfProfiler::instance().record(m_name, delta, m_cells, m_callingThreadOnly, m_outer == nullptr);
+}
@@ -0,0 +1,191 @@
+/**
+ * @file PerfCounters.h
+ * @brief Opt-in hardware performance counter instrumentation
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * Wraps phases such as Maze::generate, solveBFS and reconstructPath in
+ * scoped measurements of Linux perf_event_open counters (cycles,
+ * instructions, L1D/LLC misses, branch misses). Results are accumulated
+ * per phase and can be normalized per maze cell.
+ *
+ * Instrumentation is opt-in twice over:
+ * - MAZE_PERF_PHASE() compiles to nothing unless the build defines
+ *   MAZE_ENABLE_PERF_COUNTERS (CMake option of the same name).
+ * - Even when compiled in, nothing is measured until
+ *   PerfProfiler::instance().setEnabled(true) is called.
+ *
+ * Phases nest: an inner phase (reconstructPath) is also included in the
+ * totals of the phase around it (solveBFS).
+ *
+ * Counters only see the thread that opened them. A phase that hands work
+ * to other threads (row-parallel generation, dead-end fill stripes) says
+ * so with MAZE_PERF_WORKERS(threads); its counts then cover only the
+ * calling thread's share, and reports flag it instead of passing the
+ * per-cell figures off as the whole phase.
+ */
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @enum PerfEvent
+ * @brief Hardware events sampled for every phase
+ */
+enum PerfEvent
+{
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_L1D_MISSES,
+    PERF_LLC_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_EVENT_COUNT
+};
+
+/**
+ * @struct PerfSample
+ * @brief Counter values (and wall time) for one measured interval
+ */
+struct PerfSample
+{
+    std::uint64_t values[PERF_EVENT_COUNT] = {};
+    double seconds = 0.0;
+};
+
+/**
+ * @struct PhaseStats
+ * @brief Totals for one named phase across all of its calls
+ */
+struct PhaseStats
+{
+    std::string name;
+    std::uint64_t calls = 0;
+    std::uint64_t cells = 0;    ///< sum of maze cells processed, for per-cell figures
+    bool callingThreadOnly = false; ///< some call ran workers the counters did not see
+    PerfSample total;
+};
+
+/**
+ * @class PerfProfiler
+ * @brief Process-wide registry of per-phase counter totals.
+ *
+ * Counters are opened lazily per thread. Events the kernel or the CPU
+ * refuses (containers, VMs, perf_event_paranoid) are reported as
+ * unavailable rather than failing the run.
+ */
+class PerfProfiler
+{
+public:
+    static PerfProfiler& instance();
+
+    /**
+     * @brief Turn measurement on or off at runtime
+     */
+    void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Whether a given hardware event could be opened on this thread
+     */
+    bool isEventAvailable(PerfEvent event) const;
+
+    /**
+     * @brief Read the calling thread's counters (monotonic since open)
+     */
+    PerfSample read() const;
+
+    /**
+     * @brief Add one finished interval to a phase's totals
+     * @param callingThreadOnly the phase ran workers the counters did not see
+     * @param outermost the phase was not nested in another on its thread
+     */
+    void record(const char* phase, const PerfSample& delta, std::uint64_t cells, bool callingThreadOnly, bool outermost);
+
+    /**
+     * @brief Clear all phase totals
+     */
+    void reset();
+
+    /**
+     * @brief Snapshot of every phase recorded so far (in first-seen order)
+     */
+    std::vector<PhaseStats> getPhases() const;
+
+    /**
+     * @brief Multi-line table of all phases, normalized per cell
+     */
+    std::string formatReport() const;
+
+    /**
+     * @brief One short line for the most recent call of a phase (HUD use)
+     * @return empty string if the phase has not been recorded
+     */
+    std::string formatHudLine(const std::string& phase) const;
+
+    /**
+     * @brief Name of the phase recorded last that is not nested in
+     *        another (generate, solveBFS, ...); empty if none yet
+     */
+    std::string getLastPhase() const;
+
+private:
+    PerfProfiler() : m_enabled(false) {}
+
+    std::atomic<bool> m_enabled; // toggled by the UI while solver threads read it
+    mutable std::mutex m_mutex;
+    std::vector<PhaseStats> m_phases;
+    std::vector<PhaseStats> m_last; // most recent single call per phase
+    std::string m_lastOuter;
+};
+
+/**
+ * @class PerfPhase
+ * @brief RAII measurement of one phase; records on destruction.
+ */
+class PerfPhase
+{
+public:
+    /**
+     * @param name Phase name (string literal; stored by pointer)
+     * @param cells Cells the phase works on, for per-cell normalization
+     */
+    PerfPhase(const char* name, std::uint64_t cells);
+    ~PerfPhase();
+
+    PerfPhase(const PerfPhase&) = delete;
+    PerfPhase& operator=(const PerfPhase&) = delete;
+
+    /**
+     * @brief Note that the calling thread's innermost phase (and every
+     *        phase around it) runs part of its work on other threads
+     */
+    static void markWorkers(unsigned threads);
+
+private:
+    const char* m_name;
+    std::uint64_t m_cells;
+    bool m_active;
+    bool m_callingThreadOnly;
+    PerfPhase* m_outer;
+    PerfSample m_start;
+    std::chrono::steady_clock::time_point m_startTime;
+};
+
+#define MAZE_PERF_CONCAT_INNER(a, b) a##b
+#define MAZE_PERF_CONCAT(a, b) MAZE_PERF_CONCAT_INNER(a, b)
+
+#ifdef MAZE_ENABLE_PERF_COUNTERS
+#define MAZE_PERF_PHASE(name, cells) PerfPhase MAZE_PERF_CONCAT(perfPhase_, __LINE__)(name, cells)
+#define MAZE_PERF_WORKERS(threads) PerfPhase::markWorkers(threads)
+#else
+#define MAZE_PERF_PHASE(name, cells) ((void)0)
+#define MAZE_PERF_WORKERS(threads) ((void)0)
+#endif
+
+#endif // PERF_COUNTERS_H
@@ -0,0 +1,65 @@
+/**
+ * @file SolverArena.cpp
+ * @brief Bump allocator for per-solve scratch memory
+ * @course ECE 4122/6122 - Homework 1
+ */
+
+#include "SolverArena.h"
+#include <algorithm>
+
+namespace
+{
+    const std::size_t MIN_BLOCK_BYTES = 64 * 1024;
+}
+
+SolverArena::SolverArena(std::size_t initialBytes)
+    : m_offset(0), m_used(0), m_highWater(0)
+{
+    if (initialBytes > 0)
+    {
+        m_blocks.push_back({std::unique_ptr<unsigned char[]>(new unsigned char[initialBytes]), initialBytes});
+    }
+}
+
+void* SolverArena::allocateBytes(std::size_t bytes, std::size_t alignment)
+{
+    // blocks come from new[], so their start is suitably aligned for any T
+    std::size_t start = (m_offset + alignment - 1) & ~(alignment - 1);
+    if (m_blocks.empty() || start + bytes > m_blocks.back().size)
+    {
+        // spill into a new block; reset() merges the blocks afterwards
+        std::size_t size = std::max({bytes, MIN_BLOCK_BYTES, m_blocks.empty() ? 0 : 2 * m_blocks.back().size});
+        m_blocks.push_back({std::unique_ptr<unsigned char[]>(new unsigned char[size]), size});
+        start = 0;
+    }
+    m_offset = start + bytes;
+
+    // what a single block would need, counting worst-case alignment padding
+    m_used += bytes + alignment - 1;
+    m_highWater = std::max(m_highWater, m_used);
+    return m_blocks.back().data.get() + start;
+}
+
+void SolverArena::reset()
+{
+    if (m_blocks.size() > 1)
+    {
+        // one block large enough for everything a solve has used, plus
+        // headroom for a slightly bigger maze next time
+        std::size_t size = std::max(m_highWater + m_highWater / 4, MIN_BLOCK_BYTES);
+        m_blocks.clear();
+        m_blocks.push_back({std::unique_ptr<unsigned char[]>(new unsigned char[size]), size});
+    }
+    m_offset = 0;
+    m_used = 0;
+}
+
+std::size_t SolverArena::getCapacity() const
+{
+    std::size_t total = 0;
+    for (const Block& block : m_blocks)
+    {
+        total += block.size;
+    }
+    return total;
+}
@@ -0,0 +1,134 @@
+/**
+ * @file SolverArena.h
+ * @brief Bump allocator for per-solve scratch memory
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * A solve allocates by bumping an offset into the current block; nothing
+ * is freed individually. reset() rewinds to the start. If a solve spilled
+ * into extra blocks, reset() replaces them all with one block as large as
+ * the whole solve needed, so the next solve of a similar maze fits
+ * without touching the heap at all.
+ *
+ * Only trivially copyable, trivially destructible types may live in the
+ * arena (indices, positions): nothing is ever constructed or destroyed.
+ */
+
+#ifndef SOLVER_ARENA_H
+#define SOLVER_ARENA_H
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @class SolverArena
+ * @brief Growable bump allocator, rewound between solves
+ */
+class SolverArena
+{
+public:
+    /**
+     * @param initialBytes size of the first block (0 = allocate on first use)
+     */
+    explicit SolverArena(std::size_t initialBytes = 0);
+
+    SolverArena(const SolverArena&) = delete;
+    SolverArena& operator=(const SolverArena&) = delete;
+
+    /**
+     * @brief Uninitialized storage for count objects of type T
+     */
+    template <typename T>
+    T* allocate(std::size_t count)
+    {
+        static_assert(std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value,
+                      "SolverArena never runs constructors or destructors");
+        return static_cast<T*>(allocateBytes(count * sizeof(T), alignof(T)));
+    }
+
+    /**
+     * @brief Release everything allocated since the last reset
+     */
+    void reset();
+
+    std::size_t getCapacity() const;                    ///< bytes held in blocks
+    std::size_t getHighWater() const { return m_highWater; } ///< most bytes one solve used
+
+private:
+    struct Block
+    {
+        std::unique_ptr<unsigned char[]> data;
+        std::size_t size;
+    };
+
+    std::vector<Block> m_blocks;    // allocations go to the last block
+    std::size_t m_offset;           // bytes used in the last block
+    std::size_t m_used;             // bytes handed out since reset (incl. alignment)
+    std::size_t m_highWater;
+
+    void* allocateBytes(std::size_t bytes, std::size_t alignment);
+};
+
+/**
+ * @class ArenaQueue
+ * @brief FIFO of trivially copyable values stored in a SolverArena
+ *
+ * When the end of its storage is reached, the live range either slides
+ * back to the front (if at most half is in use) or is copied into
+ * storage twice the size; the old storage stays in the arena until its
+ * next reset.
+ */
+template <typename T>
+class ArenaQueue
+{
+public:
+    ArenaQueue(SolverArena& arena, std::size_t capacity)
+        : m_arena(arena), m_capacity(capacity > 0 ? capacity : 1), m_head(0), m_tail(0)
+    {
+        m_data = m_arena.template allocate<T>(m_capacity);
+    }
+
+    bool empty() const { return m_head == m_tail; }
+    std::size_t size() const { return m_tail - m_head; }
+    std::size_t capacity() const { return m_capacity; }
+
+    void push(const T& value)
+    {
+        if (m_tail == m_capacity)
+        {
+            grow();
+        }
+        m_data[m_tail++] = value;
+    }
+
+    T pop() { return m_data[m_head++]; }
+
+private:
+    SolverArena& m_arena;
+    T* m_data;
+    std::size_t m_capacity;
+    std::size_t m_head, m_tail;
+
+    void grow()
+    {
+        std::size_t live = m_tail - m_head;
+        if (m_head >= m_capacity / 2)
+        {
+            // at most half full: slide the live range down instead
+            std::memmove(m_data, m_data + m_head, live * sizeof(T));
+        }
+        else
+        {
+            T* data = m_arena.template allocate<T>(2 * m_capacity);
+            std::memcpy(data, m_data + m_head, live * sizeof(T));
+            m_data = data;
+            m_capacity *= 2;
+        }
+        m_head = 0;
+        m_tail = live;
+    }
+};
+
+#endif // SOLVER_ARENA_H
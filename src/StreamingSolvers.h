@@ -0,0 +1,267 @@
+/**
+ * @file StreamingSolvers.h
+ * @brief Bounded-memory solvers that read the maze only through isValidPath
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * solveBFS keeps several hash entries per cell, which fails long before
+ * the maze itself stops fitting in memory. The solvers here keep either
+ * no per-cell state (wall follower) or half a byte per cell (Trémaux),
+ * and probe the grid only through isValidPath, so the grid may live in
+ * a memory-mapped file (MappedMazeImage) or any other paged storage.
+ *
+ * Both are templates over the grid type, which needs getWidth(),
+ * getHeight(), getStart(), getEnd() and isValidPath(row, col); Maze and
+ * MappedMazeImage both qualify. The path is not collected: every cell is
+ * handed to a sink callable as it is produced.
+ */
+
+#ifndef STREAMING_SOLVERS_H
+#define STREAMING_SOLVERS_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "Pathfinder.h" // Position
+
+/**
+ * @struct StreamingSolveStats
+ * @brief Result and access statistics of one streaming solve
+ */
+struct StreamingSolveStats
+{
+    bool solved = false;
+    std::uint64_t pathLength = 0;       ///< cells passed to the sink
+    std::uint64_t steps = 0;            ///< moves made while searching
+    std::uint64_t probes = 0;           ///< isValidPath calls
+    std::uint64_t rowSwitches = 0;      ///< probes on another row than the previous probe
+    std::size_t auxiliaryBytes = 0;     ///< solver-owned memory besides the grid
+};
+
+namespace streaming_detail
+{
+    // Direction order: north, east, south, west (clockwise), so a right
+    // turn is +1 and a U-turn is +2 (mod 4).
+    const int DR[4] = {-1, 0, 1, 0};
+    const int DC[4] = {0, 1, 0, -1};
+
+    /**
+     * Counts probes and row switches around the grid's isValidPath.
+     */
+    template <typename Grid>
+    struct ProbeCounter
+    {
+        const Grid& grid;
+        StreamingSolveStats& stats;
+        int lastRow = -1;
+
+        bool operator()(int row, int col)
+        {
+            stats.probes++;
+            if (row != lastRow)
+            {
+                stats.rowSwitches++;
+                lastRow = row;
+            }
+            return grid.isValidPath(row, col);
+        }
+    };
+}
+
+/**
+ * @brief Right-hand wall follower (no per-cell state at all).
+ *
+ * Keeps one hand on the wall until the end is reached. On a perfect maze
+ * this always succeeds; the route streamed is the walk itself, which
+ * includes every dead end explored on the way in and out again, so
+ * pathLength is the walk length, not the shortest path. If the walk comes
+ * back to the start in its initial heading, the end is not reachable
+ * along this wall and solved stays false.
+ * @tparam Grid maze-like grid (see file comment)
+ * @tparam Sink callable taking const Position&
+ * @param grid maze to solve
+ * @param sink receives every cell walked, start and end included
+ * @return statistics; auxiliaryBytes is 0
+ */
+template <typename Grid, typename Sink>
+StreamingSolveStats solveWallFollower(const Grid& grid, Sink&& sink)
+{
+    using namespace streaming_detail;
+    MAZE_TRACE_ZONE("solveWallFollower");
+
+    StreamingSolveStats stats;
+    ProbeCounter<Grid> open{grid, stats};
+
+    const Position start = {grid.getStart().first, grid.getStart().second};
+    const Position end = {grid.getEnd().first, grid.getEnd().second};
+
+    Position pos = start;
+    sink(pos);
+    stats.pathLength = 1;
+    if (pos == end)
+    {
+        stats.solved = true;
+        return stats;
+    }
+
+    // initial heading: first open direction, remembered to detect a full lap
+    int heading = -1;
+    for (int d = 0; d < 4 && heading < 0; ++d)
+    {
+        if (open(pos.row + DR[d], pos.col + DC[d]))
+        {
+            heading = d;
+        }
+    }
+    if (heading < 0)
+    {
+        return stats; // start is walled in
+    }
+    const int firstHeading = heading;
+    bool firstMove = true;
+
+    while (true)
+    {
+        if (!firstMove)
+        {
+            // right, straight, left, back
+            const int turns[4] = {1, 0, 3, 2};
+            for (int turn : turns)
+            {
+                int d = (heading + turn) & 3;
+                if (open(pos.row + DR[d], pos.col + DC[d]))
+                {
+                    heading = d;
+                    break;
+                }
+            }
+            if (pos == start && heading == firstHeading)
+            {
+                return stats; // full lap without meeting the end
+            }
+        }
+        firstMove = false;
+
+        pos = {pos.row + DR[heading], pos.col + DC[heading]};
+        stats.steps++;
+        stats.pathLength++;
+        sink(pos);
+        if (pos == end)
+        {
+            stats.solved = true;
+            return stats;
+        }
+    }
+}
+
+/**
+ * @brief Trémaux's algorithm with its marks packed into 4 bits per cell.
+ *
+ * Each cell keeps a 2-bit state (unvisited, on the current route, dead
+ * end) and the 2-bit direction it was entered from. That is a depth-first
+ * search without an explicit stack: backtracking follows the stored
+ * direction. Once the end is reached the route is streamed from start to
+ * end by following the cells still marked as on the route.
+ *
+ * Works on mazes with loops too; on a perfect maze the route is the
+ * unique (shortest) path.
+ * @tparam Grid maze-like grid (see file comment)
+ * @tparam Sink callable taking const Position&
+ * @param grid maze to solve
+ * @param sink receives the route from start to end, both included
+ * @return statistics; auxiliaryBytes is width * height / 2
+ */
+template <typename Grid, typename Sink>
+StreamingSolveStats solveTremaux(const Grid& grid, Sink&& sink)
+{
+    using namespace streaming_detail;
+    MAZE_TRACE_ZONE("solveTremaux");
+
+    StreamingSolveStats stats;
+    ProbeCounter<Grid> open{grid, stats};
+
+    const int width = grid.getWidth();
+    const std::size_t cells = static_cast<std::size_t>(width) * grid.getHeight();
+
+    // two cells per byte: bits 0-1 state, bits 2-3 direction back to the parent
+    enum : std::uint8_t { UNVISITED = 0, ROUTE = 1, DEAD = 2 };
+    std::vector<std::uint8_t> marks((cells + 1) / 2, 0);
+    stats.auxiliaryBytes = marks.size();
+
+    auto getMark = [&](const Position& p) -> std::uint8_t {
+        std::size_t i = static_cast<std::size_t>(p.row) * width + p.col;
+        return (marks[i >> 1] >> ((i & 1) * 4)) & 0xF;
+    };
+    auto setMark = [&](const Position& p, std::uint8_t state, int parent) {
+        std::size_t i = static_cast<std::size_t>(p.row) * width + p.col;
+        int shift = static_cast<int>(i & 1) * 4;
+        marks[i >> 1] = static_cast<std::uint8_t>((marks[i >> 1] & ~(0xF << shift)) | ((state | (parent << 2)) << shift));
+    };
+
+    const Position start = {grid.getStart().first, grid.getStart().second};
+    const Position end = {grid.getEnd().first, grid.getEnd().second};
+    if (!open(start.row, start.col))
+    {
+        return stats;
+    }
+
+    // search
+    Position pos = start;
+    setMark(pos, ROUTE, 0);
+    while (!(pos == end))
+    {
+        bool advanced = false;
+        for (int d = 0; d < 4; ++d)
+        {
+            Position next = {pos.row + DR[d], pos.col + DC[d]};
+            if (open(next.row, next.col) && (getMark(next) & 3) == UNVISITED)
+            {
+                setMark(next, ROUTE, (d + 2) & 3);
+                pos = next;
+                advanced = true;
+                break;
+            }
+        }
+        if (!advanced)
+        {
+            if (pos == start)
+            {
+                return stats; // everything reachable explored, no end
+            }
+            int back = getMark(pos) >> 2;
+            setMark(pos, DEAD, back);
+            pos = {pos.row + DR[back], pos.col + DC[back]};
+        }
+        stats.steps++;
+    }
+
+    // stream the route: the next route cell is the neighbour whose
+    // parent direction points back here (the marks alone, no grid probes)
+    stats.solved = true;
+    pos = start;
+    while (true)
+    {
+        sink(pos);
+        stats.pathLength++;
+        if (pos == end)
+        {
+            break;
+        }
+        for (int d = 0; d < 4; ++d)
+        {
+            Position next = {pos.row + DR[d], pos.col + DC[d]};
+            if (next.row >= 0 && next.row < grid.getHeight() && next.col >= 0 && next.col < width &&
+                !(next == start))
+            {
+                std::uint8_t mark = getMark(next);
+                if ((mark & 3) == ROUTE && (mark >> 2) == ((d + 2) & 3))
+                {
+                    pos = next;
+                    break;
+                }
+            }
+        }
+    }
+    return stats;
+}
+
+#endif // STREAMING_SOLVERS_H
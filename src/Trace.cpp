@@ -0,0 +1,160 @@
+/**
+ * @file Trace.cpp
+ * @brief Implementation of the per-thread trace rings and JSON export
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * Timestamps are raw TSC ticks on x86 (cheapest clock available) and
+ * steady_clock nanoseconds elsewhere. The tick rate is calibrated at dump
+ * time against steady_clock, using the pair captured when the Tracer was
+ * created.
+ */
+
+#include "Trace.h"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define MAZE_TRACE_USE_TSC 1
+#endif
+
+namespace
+{
+    std::int64_t clockNanos()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+std::uint64_t traceNow()
+{
+#ifdef MAZE_TRACE_USE_TSC
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(clockNanos());
+#endif
+}
+
+std::vector<TraceEvent> TraceBuffer::snapshot() const
+{
+    std::uint64_t written = m_written.load(std::memory_order_acquire);
+    std::uint64_t first = written > CAPACITY ? written - CAPACITY : 0;
+
+    std::vector<TraceEvent> events;
+    events.reserve(static_cast<std::size_t>(written - first));
+    for (std::uint64_t i = first; i < written; ++i)
+    {
+        events.push_back(m_events[i & (CAPACITY - 1)]);
+    }
+    return events;
+}
+
+Tracer::Tracer() : m_originTicks(traceNow()), m_originNanos(clockNanos())
+{
+}
+
+Tracer& Tracer::instance()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+TraceBuffer& Tracer::threadBuffer()
+{
+    // returns the ring to the registry when the thread exits
+    struct Lease
+    {
+        TraceBuffer* buffer;
+        Lease() : buffer(&instance().registerThread()) {}
+        ~Lease() { instance().releaseThread(*buffer); }
+    };
+    thread_local Lease lease;
+    return *lease.buffer;
+}
+
+TraceBuffer& Tracer::registerThread()
+{
+    // buffers are owned by the registry so zones survive thread exit
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_free.empty())
+    {
+        TraceBuffer* buffer = m_free.back();
+        m_free.pop_back();
+        return *buffer;
+    }
+    m_buffers.push_back(std::make_shared<TraceBuffer>(static_cast<int>(m_buffers.size()) + 1));
+    return *m_buffers.back();
+}
+
+void Tracer::releaseThread(TraceBuffer& buffer)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_free.push_back(&buffer);
+}
+
+std::uint64_t Tracer::getZoneCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::uint64_t count = 0;
+    for (const auto& buffer : m_buffers)
+    {
+        count += buffer->snapshot().size();
+    }
+    return count;
+}
+
+bool Tracer::dumpChromeJson(const std::string& path)
+{
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        buffers = m_buffers;
+    }
+
+    // ticks -> microseconds since the tracer was created
+    double ticksPerMicro = 1000.0;
+    std::uint64_t nowTicks = traceNow();
+    std::int64_t nowNanos = clockNanos();
+    if (nowTicks > m_originTicks && nowNanos > m_originNanos)
+    {
+        ticksPerMicro = static_cast<double>(nowTicks - m_originTicks) / ((nowNanos - m_originNanos) / 1000.0);
+    }
+
+    std::ofstream file(path);
+    if (!file)
+    {
+        return false;
+    }
+
+    file << std::fixed << std::setprecision(3);
+    file << "{\"traceEvents\":[\n";
+    bool first = true;
+    for (const auto& buffer : buffers)
+    {
+        int tid = buffer->getThreadId();
+        file << (first ? "" : ",\n")
+             << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+             << ",\"args\":{\"name\":\"thread " << tid << "\"}}";
+        first = false;
+
+        for (const TraceEvent& event : buffer->snapshot())
+        {
+            if (event.start < m_originTicks || event.end < event.start)
+            {
+                continue; // torn by a concurrent write
+            }
+            double ts = (event.start - m_originTicks) / ticksPerMicro;
+            double dur = (event.end - event.start) / ticksPerMicro;
+            file << ",\n{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+                 << ",\"ts\":" << ts << ",\"dur\":" << dur << "}";
+        }
+    }
+    file << "\n]}\n";
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,274 @@
+/**
+ * @file bench_main.cpp
+ * @brief Headless benchmark for maze generation and solving
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * Usage:
+ *   MazeBench <width> <height> [options]
+ *
+ * Options:
+ *   --runs N       generate + solve N times (default 5)
+ *   --solver NAME  solver to run: bfs (default), bfs8 (diagonal moves too),
+ *                  hpa, deadend, tremaux, wall
+ *   --cluster N    HPA* cluster size (default 32)
+ *   --threads N    dead-end fill stripes (default 0 = all cores)
+ *   --generator G  backtracker (default), binarytree, sidewinder
+ *   --layout L     cell storage: rowmajor (default) or tiled (8x8 blocks)
+ *   --seed S       run r generates from seed S + r, so runs with different
+ *                  options time identical mazes (default: clock seeded)
+ *   --perf         print per-phase hardware counters, normalized per cell
+ *                  (needs a build with MAZE_ENABLE_PERF_COUNTERS=ON)
+ *
+ * bfs, bfs8 and deadend reuse one SolverWorkspace across runs. Every run
+ * reports the heap allocations made during its solve (counted by the
+ * global operator new below), which should drop to zero once the
+ * workspace has warmed up.
+ */
+
+#include "MazeGenerator.h"
+#include "Pathfinder.h"
+#include "HierarchicalPathfinder.h"
+#include "StreamingSolvers.h"
+#include "PerfCounters.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+
+// same headless limit as MazeExport
+const int MAX_BENCH_DIMENSION = 1 << 30;
+
+// every heap allocation of the process, for the per-solve allocation count
+std::atomic<std::uint64_t> heapAllocations(0);
+
+void* operator new(std::size_t size)
+{
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+/**
+ * @brief Prints usage information to stderr.
+ */
+void printUsage()
+{
+    std::cerr << "Usage: MazeBench <width> <height> [--runs N] [--solver bfs|bfs8|hpa|deadend|tremaux|wall] [--cluster N] [--threads N] [--generator G] [--layout rowmajor|tiled] [--seed S] [--perf]" << std::endl;
+}
+
+/**
+ * @brief Runs the named solver once without any visualization.
+ * @param maze maze to solve
+ * @param solver solver name from the command line
+ * @param hierarchy HPA* abstraction of maze (only used by "hpa")
+ * @param threads dead-end fill stripes (only used by "deadend")
+ * @param nodes number of nodes explored
+ * @param streaming filled in by the bounded-memory solvers ("tremaux", "wall")
+ * @param workspace buffers reused across runs ("bfs", "bfs8", "deadend")
+ * @return path length, 0 if no path was found
+ */
+std::size_t runSolver(Maze& maze, const std::string& solver, HierarchicalPathfinder* hierarchy, unsigned threads, int& nodes,
+                      StreamingSolveStats& streaming, SolverWorkspace& workspace)
+{
+    if (solver == "tremaux" || solver == "wall")
+    {
+        auto discard = [](const Position&) {};
+        streaming = solver == "wall" ? solveWallFollower(maze, discard) : solveTremaux(maze, discard);
+        nodes = static_cast<int>(streaming.steps);
+        return streaming.solved ? static_cast<std::size_t>(streaming.pathLength) : 0;
+    }
+    if (solver == "hpa")
+    {
+        return solveHierarchical(maze, *hierarchy, nodes).size();
+    }
+    if (solver == "deadend")
+    {
+        NullObserver observer;
+        return solveDeadEndFill(maze, observer, nodes, workspace, threads).size();
+    }
+    NullObserver observer;
+    if (solver == "bfs8")
+    {
+        return solveBFS<EightConnected>(maze, observer, nodes, workspace).size();
+    }
+    return solveBFS(maze, observer, nodes, workspace).size();
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        printUsage();
+        return 1;
+    }
+
+    int width, height;
+    int runs = 5;
+    std::string solver = "bfs";
+    int clusterSize = 32;
+    unsigned threads = 0;
+    GeneratorAlgorithm generator = GeneratorAlgorithm::Backtracker;
+    CellLayout layout = CellLayout::RowMajor;
+    bool perf = false;
+    bool seeded = false;
+    std::uint32_t seed = 0;
+
+    try
+    {
+        width = std::stoi(argv[1]);
+        height = std::stoi(argv[2]);
+        for (int i = 3; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            if (arg == "--runs" && i + 1 < argc)
+            {
+                runs = std::stoi(argv[++i]);
+            }
+            else if (arg == "--solver" && i + 1 < argc)
+            {
+                solver = argv[++i];
+            }
+            else if (arg == "--cluster" && i + 1 < argc)
+            {
+                clusterSize = std::stoi(argv[++i]);
+            }
+            else if (arg == "--threads" && i + 1 < argc)
+            {
+                threads = static_cast<unsigned>(std::stoi(argv[++i]));
+            }
+            else if (arg == "--generator" && i + 1 < argc && parseGeneratorAlgorithm(argv[i + 1], generator))
+            {
+                ++i;
+            }
+            else if (arg == "--layout" && i + 1 < argc && (std::string(argv[i + 1]) == "rowmajor" || std::string(argv[i + 1]) == "tiled"))
+            {
+                layout = std::string(argv[++i]) == "tiled" ? CellLayout::Tiled : CellLayout::RowMajor;
+            }
+            else if (arg == "--seed" && i + 1 < argc)
+            {
+                seed = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+                seeded = true;
+            }
+            else if (arg == "--perf")
+            {
+                perf = true;
+            }
+            else
+            {
+                printUsage();
+                return 1;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        printUsage();
+        return 1;
+    }
+
+    if (solver != "bfs" && solver != "bfs8" && solver != "hpa" && solver != "deadend" && solver != "tremaux" && solver != "wall")
+    {
+        std::cerr << "Unknown solver: " << solver << std::endl;
+        return 1;
+    }
+
+#ifndef MAZE_ENABLE_PERF_COUNTERS
+    if (perf)
+    {
+        std::cerr << "Built without MAZE_ENABLE_PERF_COUNTERS; reporting wall time only." << std::endl;
+        perf = false;
+    }
+#endif
+    PerfProfiler::instance().setEnabled(perf);
+
+    using Clock = std::chrono::steady_clock;
+    auto millis = [](Clock::time_point from) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - from).count();
+    };
+
+    Maze maze(width, height, MAX_BENCH_DIMENSION);
+    maze.setAlgorithm(generator);
+    maze.setLayout(layout);
+    std::cout << "maze " << maze.getWidth() << "x" << maze.getHeight() << ", generator " << generatorName(generator)
+              << ", layout " << (layout == CellLayout::Tiled ? "tiled" : "rowmajor") << ", solver " << solver;
+    if (seeded)
+    {
+        std::cout << ", seed " << seed;
+    }
+    std::cout << std::endl;
+
+    SolverWorkspace workspace;
+    double generateTotal = 0.0, solveTotal = 0.0;
+    for (int run = 0; run < runs; ++run)
+    {
+        if (seeded)
+        {
+            maze.seed(seed + static_cast<std::uint32_t>(run));
+        }
+        auto t0 = Clock::now();
+        maze.generate();
+        double generateMs = millis(t0);
+
+        // HPA* abstraction is built once per maze, outside the timed query
+        std::unique_ptr<HierarchicalPathfinder> hierarchy;
+        double buildMs = 0.0;
+        if (solver == "hpa")
+        {
+            t0 = Clock::now();
+            hierarchy.reset(new HierarchicalPathfinder(maze, clusterSize));
+            buildMs = millis(t0);
+        }
+
+        int nodes = 0;
+        StreamingSolveStats streaming;
+        std::uint64_t allocationsBefore = heapAllocations.load();
+        t0 = Clock::now();
+        std::size_t pathLength = runSolver(maze, solver, hierarchy.get(), threads, nodes, streaming, workspace);
+        double solveMs = millis(t0);
+        std::uint64_t allocations = heapAllocations.load() - allocationsBefore;
+
+        generateTotal += generateMs;
+        solveTotal += solveMs;
+        std::cout << "run " << run << ": generate " << generateMs << " ms, ";
+        if (hierarchy)
+        {
+            std::cout << "build " << buildMs << " ms (" << hierarchy->getClusterCount() << " clusters, "
+                      << hierarchy->getAbstractNodeCount() << " nodes), ";
+        }
+        std::cout << "solve " << solveMs << " ms, nodes " << nodes << ", path " << pathLength << ", allocs " << allocations;
+        if (solver == "tremaux" || solver == "wall")
+        {
+            std::cout << ", aux " << streaming.auxiliaryBytes << " bytes, " << streaming.probes << " probes ("
+                      << streaming.rowSwitches << " row switches)";
+        }
+        std::cout << std::endl;
+    }
+
+    if (runs > 0)
+    {
+        std::cout << "mean: generate " << generateTotal / runs << " ms, solve " << solveTotal / runs << " ms" << std::endl;
+    }
+
+    if (perf)
+    {
+        std::cout << "\n" << PerfProfiler::instance().formatReport();
+    }
+    return 0;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file export_main.cpp
+ * @brief Headless maze/solution image exporter (no SFML, no OpenGL context)
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * Usage:
+ *   MazeExport <width> <height> <output.png|output.ppm> [options]
+ *
+ * Options:
+ *   --scale N      pixels per cell edge (default 1)
+ *   --threads N    rasterizer threads (default: all cores)
+ *   --generator G  backtracker (default), binarytree, sidewinder
+ *   --solve        solve with BFS before exporting (draws the overlay)
+ *   --frames P     also write solve frames as P_00000.png, P_00001.png, ...
+ *   --every N      nodes explored between frames (default 1000)
+ */
+
+#include "MazeGenerator.h"
+#include "Pathfinder.h"
+#include "MazeRasterizer.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+// no upper clamp for headless mazes beyond what an int row index can hold
+const int MAX_EXPORT_DIMENSION = 1 << 30;
+
+/**
+ * @brief Prints usage information to stderr.
+ */
+void printUsage()
+{
+    std::cerr << "Usage: MazeExport <width> <height> <output.png|output.ppm> "
+              << "[--scale N] [--threads N] [--generator G] [--solve] [--frames PREFIX] [--every N]" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 4)
+    {
+        printUsage();
+        return 1;
+    }
+
+    int width, height;
+    std::string output = argv[3];
+    RasterOptions options;
+    bool solve = false;
+    std::string framePrefix;
+    int every = 1000;
+    GeneratorAlgorithm generator = GeneratorAlgorithm::Backtracker;
+
+    try
+    {
+        width = std::stoi(argv[1]);
+        height = std::stoi(argv[2]);
+        for (int i = 4; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            if (arg == "--scale" && i + 1 < argc)
+            {
+                options.scale = std::stoi(argv[++i]);
+            }
+            else if (arg == "--threads" && i + 1 < argc)
+            {
+                options.threads = static_cast<unsigned>(std::stoi(argv[++i]));
+            }
+            else if (arg == "--generator" && i + 1 < argc && parseGeneratorAlgorithm(argv[i + 1], generator))
+            {
+                ++i;
+            }
+            else if (arg == "--solve")
+            {
+                solve = true;
+            }
+            else if (arg == "--frames" && i + 1 < argc)
+            {
+                framePrefix = argv[++i];
+                solve = true; // frames only make sense for a solve
+            }
+            else if (arg == "--every" && i + 1 < argc)
+            {
+                every = std::stoi(argv[++i]);
+            }
+            else
+            {
+                printUsage();
+                return 1;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        printUsage();
+        return 1;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    auto seconds = [](Clock::time_point from) {
+        return std::chrono::duration<double>(Clock::now() - from).count();
+    };
+
+    Maze maze(width, height, MAX_EXPORT_DIMENSION);
+    maze.setAlgorithm(generator);
+    auto t0 = Clock::now();
+    maze.generate();
+    std::cout << "generate " << maze.getWidth() << "x" << maze.getHeight()
+              << ": " << seconds(t0) << " s" << std::endl;
+
+    ImageFormat format = formatFromPath(output);
+    if (solve)
+    {
+        SolveFrameExporter frames(framePrefix, format, options, every);
+        std::function<void(bool)> renderer;
+        if (!framePrefix.empty())
+        {
+            renderer = [&](bool) { frames.capture(maze); };
+        }
+
+        float delay = 0.0f;
+        int nodes = 0;
+        t0 = Clock::now();
+        std::vector<Position> path = solveBFS(maze, renderer, delay, nodes);
+        std::cout << "solve: " << seconds(t0) << " s, nodes " << nodes
+                  << ", path " << path.size() << std::endl;
+
+        if (!framePrefix.empty())
+        {
+            frames.flush(maze); // final frame shows the solution
+            std::cout << "frames written: " << frames.getFrameCount() - frames.getFailedCount() << std::endl;
+            if (frames.failed())
+            {
+                std::cerr << "Failed to write " << frames.getFailedCount() << " of " << frames.getFrameCount()
+                          << " frames (first: " << frames.getFirstFailure() << ")" << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    t0 = Clock::now();
+    if (!exportMazeImage(maze, output, format, options))
+    {
+        std::cerr << "Failed to write " << output << std::endl;
+        return 1;
+    }
+    std::cout << "export " << output << ": " << seconds(t0) << " s" << std::endl;
+    return 0;
+}
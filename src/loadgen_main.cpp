@@ -0,0 +1,321 @@
+/**
+ * @file loadgen_main.cpp
+ * @brief Load generator for MazeServer: throughput and tail latency
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * Usage:
+ *   MazeLoadGen [options]
+ *
+ * Options:
+ *   --socket PATH    daemon socket (default /tmp/mazed.sock)
+ *   --clients N      concurrent connections (default 4)
+ *   --requests N     requests per connection (default 10000)
+ *   --depth N        requests in flight per connection (default 8)
+ *   --op NAME        solve (default), packed (2-bit moves), distance or generate
+ *   --size N         maze width and height (default 201)
+ *   --seeds N        distinct mazes queried (default 4), all generated
+ *                    before timing starts
+ *   --generator G    backtracker (default), binarytree, sidewinder
+ *
+ * Endpoints are random open cells. Latency is measured per request from
+ * send to the end of its response, so it includes queueing behind the
+ * other requests in flight.
+ */
+
+#include "MazeProtocol.h"
+#include "MazeGenerator.h"
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @struct LoadOptions
+ * @brief Command-line settings shared by every client thread
+ */
+struct LoadOptions
+{
+    std::string socketPath = "/tmp/mazed.sock";
+    int clients = 4;
+    int requests = 10000;
+    int depth = 8;
+    std::uint8_t op = MAZE_OP_SOLVE;
+    int size = 201;
+    int seeds = 4;
+    GeneratorAlgorithm generator = GeneratorAlgorithm::Backtracker;
+};
+
+/**
+ * @struct ClientResult
+ * @brief What one connection measured
+ */
+struct ClientResult
+{
+    std::vector<double> latencyMicros;
+    long long failures = 0;     // non-OK responses
+    bool connected = false;
+};
+
+/**
+ * @brief Prints usage information to stderr.
+ */
+void printUsage()
+{
+    std::cerr << "Usage: MazeLoadGen [--socket PATH] [--clients N] [--requests N] [--depth N] "
+              << "[--op solve|packed|distance|generate] [--size N] [--seeds N] [--generator G]" << std::endl;
+}
+
+/**
+ * @brief Reads one response and skips its payload.
+ * @return false if the connection broke
+ */
+bool readResponse(int fd, MazeResponse& response, std::vector<std::uint8_t>& payload)
+{
+    if (!readFully(fd, &response, sizeof(response)))
+    {
+        return false;
+    }
+    payload.resize(response.payloadBytes);
+    return response.payloadBytes == 0 || readFully(fd, payload.data(), payload.size());
+}
+
+/**
+ * @brief Makes every maze of the run resident before timing starts, so
+ * no measured request pays for a generation.
+ * @param options load settings
+ * @param width set to the actual maze width (after the server's clamping)
+ * @param height set to the actual maze height
+ * @return false if the server cannot be reached or refuses a maze
+ */
+bool warmUp(const LoadOptions& options, int& width, int& height)
+{
+    int fd = connectMazeServer(options.socketPath.c_str());
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    MazeRequest request;
+    request.op = MAZE_OP_GENERATE;
+    request.generator = static_cast<std::uint8_t>(options.generator);
+    request.width = options.size;
+    request.height = options.size;
+
+    // all seeds pipelined: the server generates them as one batch
+    bool ok = true;
+    for (int seed = 0; seed < options.seeds && ok; ++seed)
+    {
+        request.id = static_cast<std::uint32_t>(seed);
+        request.seed = static_cast<std::uint32_t>(seed);
+        ok = writeFully(fd, &request, sizeof(request));
+    }
+    MazeResponse response;
+    std::vector<std::uint8_t> payload;
+    for (int seed = 0; seed < options.seeds && ok; ++seed)
+    {
+        ok = readResponse(fd, response, payload) && response.status == MAZE_STATUS_OK;
+    }
+    close(fd);
+    width = response.width;
+    height = response.height;
+    return ok;
+}
+
+/**
+ * @brief One connection: keep depth requests in flight on the warmed-up mazes.
+ * @param options load settings
+ * @param width actual maze width (from warmUp)
+ * @param height actual maze height
+ * @param clientId used to seed this client's random endpoints
+ * @param result filled with per-request latencies
+ */
+void runClient(const LoadOptions& options, int width, int height, int clientId, ClientResult& result)
+{
+    int fd = connectMazeServer(options.socketPath.c_str());
+    if (fd < 0)
+    {
+        return;
+    }
+    result.connected = true;
+    std::mt19937 rng(static_cast<unsigned>(clientId) * 7919u + 1);
+
+    MazeRequest request;
+    request.generator = static_cast<std::uint8_t>(options.generator);
+    request.width = options.size;
+    request.height = options.size;
+
+    MazeResponse response;
+    std::vector<std::uint8_t> payload;
+    // odd coordinates are open cells in every generated maze
+    std::uniform_int_distribution<int> rowDist(0, (height - 3) / 2);
+    std::uniform_int_distribution<int> colDist(0, (width - 3) / 2);
+    std::uniform_int_distribution<int> seedDist(0, options.seeds - 1);
+
+    request.op = options.op;
+    result.latencyMicros.reserve(options.requests);
+    std::deque<Clock::time_point> inFlight; // responses come back in request order
+    int sent = 0, received = 0;
+    while (received < options.requests)
+    {
+        while (sent < options.requests && static_cast<int>(inFlight.size()) < options.depth)
+        {
+            request.id = static_cast<std::uint32_t>(sent);
+            request.seed = static_cast<std::uint32_t>(seedDist(rng));
+            request.fromRow = 2 * rowDist(rng) + 1;
+            request.fromCol = 2 * colDist(rng) + 1;
+            request.toRow = 2 * rowDist(rng) + 1;
+            request.toCol = 2 * colDist(rng) + 1;
+            inFlight.push_back(Clock::now());
+            if (!writeFully(fd, &request, sizeof(request)))
+            {
+                close(fd);
+                return;
+            }
+            sent++;
+        }
+
+        if (!readResponse(fd, response, payload))
+        {
+            break;
+        }
+        result.latencyMicros.push_back(std::chrono::duration<double, std::micro>(Clock::now() - inFlight.front()).count());
+        inFlight.pop_front();
+        received++;
+        if (response.status != MAZE_STATUS_OK)
+        {
+            result.failures++;
+        }
+    }
+    close(fd);
+}
+
+int main(int argc, char* argv[])
+{
+    LoadOptions options;
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            if (arg == "--socket" && i + 1 < argc)
+            {
+                options.socketPath = argv[++i];
+            }
+            else if (arg == "--clients" && i + 1 < argc)
+            {
+                options.clients = std::stoi(argv[++i]);
+            }
+            else if (arg == "--requests" && i + 1 < argc)
+            {
+                options.requests = std::stoi(argv[++i]);
+            }
+            else if (arg == "--depth" && i + 1 < argc)
+            {
+                options.depth = std::max(1, std::stoi(argv[++i]));
+            }
+            else if (arg == "--op" && i + 1 < argc)
+            {
+                std::string op = argv[++i];
+                if (op == "solve") options.op = MAZE_OP_SOLVE;
+                else if (op == "packed") options.op = MAZE_OP_SOLVE_PACKED;
+                else if (op == "distance") options.op = MAZE_OP_DISTANCE;
+                else if (op == "generate") options.op = MAZE_OP_GENERATE;
+                else
+                {
+                    printUsage();
+                    return 1;
+                }
+            }
+            else if (arg == "--size" && i + 1 < argc)
+            {
+                options.size = std::stoi(argv[++i]);
+            }
+            else if (arg == "--seeds" && i + 1 < argc)
+            {
+                options.seeds = std::stoi(argv[++i]);
+            }
+            else if (arg == "--generator" && i + 1 < argc && parseGeneratorAlgorithm(argv[i + 1], options.generator))
+            {
+                ++i;
+            }
+            else
+            {
+                printUsage();
+                return 1;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        printUsage();
+        return 1;
+    }
+    if (options.clients < 1 || options.seeds < 1)
+    {
+        std::cerr << "--clients and --seeds must be at least 1" << std::endl;
+        return 1;
+    }
+
+    // not measured: generate every maze the clients will ask about
+    int width = 0, height = 0;
+    if (!warmUp(options, width, height))
+    {
+        std::cerr << "Cannot warm up " << options.seeds << " mazes on " << options.socketPath << std::endl;
+        return 1;
+    }
+
+    std::vector<ClientResult> results(options.clients);
+    std::vector<std::thread> threads;
+    auto t0 = Clock::now();
+    for (int c = 0; c < options.clients; ++c)
+    {
+        threads.emplace_back(runClient, std::cref(options), width, height, c, std::ref(results[c]));
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    std::vector<double> latencies;
+    long long failures = 0;
+    int connected = 0;
+    for (const ClientResult& result : results)
+    {
+        latencies.insert(latencies.end(), result.latencyMicros.begin(), result.latencyMicros.end());
+        failures += result.failures;
+        connected += result.connected ? 1 : 0;
+    }
+    if (connected == 0)
+    {
+        std::cerr << "Cannot connect to " << options.socketPath << std::endl;
+        return 1;
+    }
+    if (latencies.empty())
+    {
+        std::cerr << "No responses received" << std::endl;
+        return 1;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) {
+        std::size_t index = static_cast<std::size_t>(p / 100.0 * (latencies.size() - 1) + 0.5);
+        return latencies[index];
+    };
+
+    std::cout << connected << " clients x depth " << options.depth << ": " << latencies.size() << " requests in "
+              << seconds << " s, " << latencies.size() / seconds << " QPS, " << failures << " failed" << std::endl;
+    std::cout << "latency us: p50 " << percentile(50) << ", p90 " << percentile(90) << ", p99 " << percentile(99)
+              << ", p99.9 " << percentile(99.9) << ", max " << latencies.back() << std::endl;
+    return 0;
+}
@@ -9,48 +9,203 @@ Handles SFML window, user input, and rendering.
 #include <SFML/Graphics.hpp>
 #include "MazeGenerator.h"
 #include "Pathfinder.h"
+#include "HierarchicalPathfinder.h" // race view solver
+#include "StreamingSolvers.h" // race view solver
+#include "PathCache.h" // repeated S/D on an unchanged maze
+#include "MazeRasterizer.h" // shared cell color palette
+#include "PerfCounters.h" // optional HUD counter line
+#include "Trace.h" // optional trace zones (MAZE_ENABLE_TRACING)
 #include <iostream>
 #include <iomanip>
 #include <string>
+#include <algorithm>
+#include <cctype>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
 
-struct ResetException : public std::exception {};
+struct ResetException : public std::exception
+{
+    sf::Keyboard::Key key; // R or G, whichever interrupted the solve
+    explicit ResetException(sf::Keyboard::Key k) : key(k) {}
+};
 // using this struct to handle reset/gen during BFS
 
+struct RaceCancelled : public std::exception {};
+// thrown inside a race pane's solver to stop it early
+
+/**
+ * @struct RacePane
+ * @brief One solver of the split-screen race (V key).
+ *
+ * The solver thread works on its own copy of the maze and mirrors what
+ * it discovers into view, the copy the UI draws, under mutex. Stats are
+ * atomics so the UI can show them live.
+ */
+struct RacePane
+{
+    std::string name;
+    Maze view;                          // guarded by mutex
+    std::mutex mutex;
+    std::thread worker;
+    std::atomic<long long> nodes{0};
+    std::atomic<long long> micros{0};   // solver time so far, animation delay excluded
+    std::atomic<int> pathLength{-1};
+    std::atomic<bool> done{false};
+
+    RacePane(const std::string& solverName, const Maze& maze) : name(solverName), view(maze) {}
+};
+
+/// solvers raced side by side, in pane order
+const char* const RACE_SOLVERS[4] = {"BFS", "DEAD-END FILL", "TREMAUX", "HPA*"};
+
+/**
+ * @struct RaceObserver
+ * @brief Solver observer of a race pane: counts, mirrors the discovered
+ * cell into the pane's view and applies the animation delay.
+ */
+struct RaceObserver
+{
+    RacePane& pane;
+    const std::atomic<bool>& cancel;
+    sf::Time delay;
+    sf::Clock clock;            // started with the solve
+    sf::Time slept;             // animation delay so far
+
+    void onDiscover(Maze&, const Position& pos)
+    {
+        pane.nodes++;
+        {
+            std::lock_guard<std::mutex> lock(pane.mutex);
+            if (pane.view.getCell(pos.row, pos.col).type == CellType::Path)
+            {
+                pane.view.setCellType(pos.row, pos.col, CellType::Visited);
+            }
+        }
+        pane.micros = (clock.getElapsedTime() - slept).asMicroseconds();
+        if (cancel)
+        {
+            throw RaceCancelled();
+        }
+        sf::sleep(delay);
+        slept += delay;
+    }
+};
+
+/**
+ * @struct RaceGrid
+ * @brief Grid view of a race pane's maze for the streaming solvers, which
+ * have no observer: every probe checks the race's cancel flag instead.
+ */
+struct RaceGrid
+{
+    const Maze& maze;
+    const std::atomic<bool>& cancel;
+
+    int getWidth() const { return maze.getWidth(); }
+    int getHeight() const { return maze.getHeight(); }
+    std::pair<int, int> getStart() const { return maze.getStart(); }
+    std::pair<int, int> getEnd() const { return maze.getEnd(); }
+    bool isValidPath(int row, int col) const
+    {
+        if (cancel.load(std::memory_order_relaxed))
+        {
+            throw RaceCancelled();
+        }
+        return maze.isValidPath(row, col);
+    }
+};
+
+/**
+ * @struct HudValues
+ * @brief Values currently shown in the HUD, so text is only rebuilt
+ * (and re-laid out) when one of them changes.
+ */
+struct HudValues
+{
+    int width = -1, height = -1;
+    std::string solver;
+    GeneratorAlgorithm generator = GeneratorAlgorithm::Backtracker;
+    std::string status;
+    int path = -2, nodes = -1;
+    int delayMS = -1;
+    std::string perfLine;
+};
+
 // UI Updater function
 /**
-     * @brief UI Updater
+     * @brief UI Updater, only rebuilds a column when its values changed
      * @param sizeAlgo reference to sf::Text object for left column (Size, Algorithm)
      * @param stats reference to sf::Text object for middle column (Statistics, Status)
      * @param controls reference to sf::Text object for right column (Controls and Speed)
      * @param maze read-only reference to current maze object
+     * @param solver name of the solver last used (BFS, DEAD-END FILL)
      * @param status string stating status: solving, reset, generating
      * @param path length of found path. -1 if no path found yet.
      * @param nodes number of nodes explored by BFS
      * @param delay read-only reference to delay float from main
+     * @param perfLine optional hardware counter summary, empty to hide
+     * @param shown values currently displayed, updated in place
+     * @return true if any text changed (the columns need re-positioning)
      * 
      */
-void updateStatus(sf::Text& sizeAlgo, sf::Text& stats, sf::Text& controls, const Maze& maze, const std::string status, int path, int nodes, const float& delay) {
-    
+bool updateStatus(sf::Text& sizeAlgo, sf::Text& stats, sf::Text& controls, const Maze& maze, const std::string& solver, const std::string status, int path, int nodes, const float& delay, const std::string& perfLine, HudValues& shown) {
+    MAZE_TRACE_ZONE("updateStatus");
+    bool changed = false;
     
     // left column: size and algorithm
-    std::string height = std::to_string(maze.getHeight());
-    std::string width = std::to_string(maze.getWidth());
-    std::string sizeStr = "SIZE: " + width + "x" + height;
-    sizeStr += "\n\nALGORITHM: BFS"; 
-    sizeAlgo.setString(sizeStr); // update the string from main
+    if (maze.getWidth() != shown.width || maze.getHeight() != shown.height || maze.getAlgorithm() != shown.generator || solver != shown.solver)
+    {
+        shown.solver = solver;
+        shown.width = maze.getWidth();
+        shown.height = maze.getHeight();
+        shown.generator = maze.getAlgorithm();
+        std::string height = std::to_string(maze.getHeight());
+        std::string width = std::to_string(maze.getWidth());
+        std::string sizeStr = "SIZE: " + width + "x" + height;
+        sizeStr += "\n\nALGORITHM: " + solver;
+        std::string generatorStr = generatorName(maze.getAlgorithm());
+        std::transform(generatorStr.begin(), generatorStr.end(), generatorStr.begin(), ::toupper);
+        sizeStr += "\n\nGENERATOR: " + generatorStr;
+        sizeAlgo.setString(sizeStr); // update the string from main
+        changed = true;
+    }
 
     // middle column: statisics and status
-    std::string statsStr = "STATUS: " + status;
-    statsStr += "\n\nNODES EXPLORED: " + std::to_string(nodes);
-    statsStr += "\n\nPATH LENGTH: " + (path == -1 ? "N/A" : std::to_string(path));
-    stats.setString(statsStr); // update the string from main
+    if (status != shown.status || path != shown.path || nodes != shown.nodes || perfLine != shown.perfLine)
+    {
+        shown.status = status;
+        shown.path = path;
+        shown.nodes = nodes;
+        shown.perfLine = perfLine;
+        std::string statsStr = "STATUS: " + status;
+        statsStr += "\n\nNODES EXPLORED: " + std::to_string(nodes);
+        statsStr += "\n\nPATH LENGTH: " + (path == -1 ? "N/A" : std::to_string(path));
+        if (!perfLine.empty())
+        {
+            statsStr += "\n\n" + perfLine;
+        }
+        stats.setString(statsStr); // update the string from main
+        changed = true;
+    }
 
     // right column: controls
     int delayMS = static_cast<int>(delay * 1000);
-    std::string controlStr = "G:   GENERATE\n\nS:   SOLVE\n\nR:   RESET\n\n";
-    controlStr += "+/-: SPEED (" + std::to_string(delayMS) + "ms)\n\n";
-    controlStr += "ESC: EXIT";
-    controls.setString(controlStr); // update the string from main
+    if (delayMS != shown.delayMS)
+    {
+        shown.delayMS = delayMS;
+        // two keys per line so the column still fits in the top bar
+        std::string controlStr = "G: GENERATE  M: TYPE\n\nS: BFS  X: 8-WAY  D: FILL\n\nR: RESET     V: RACE\n\n";
+        controlStr += "+/-: SPEED (" + std::to_string(delayMS) + "ms)\n\n";
+        controlStr += "P: PERF    ESC: EXIT";
+        controls.setString(controlStr); // update the string from main
+        changed = true;
+    }
+    return changed;
 };
 
 
@@ -100,25 +255,22 @@ void handleArguments(int argc, char* argv[], int& width, int&height){
 
 // maze renderer
 /**
- * @brief Draws the maze grid to the screen based on current window size.
+ * @brief Draws the maze grid into a rectangle of the window.
  * @param window The SFML window object we draw on
  * @param maze The maze data structure
- * @param topOffset height of black UI bar at the top
+ * @param left left edge of the area in pixels
+ * @param top top edge of the area in pixels
+ * @param areaWidth width of the area in pixels
+ * @param areaHeight height of the area in pixels
  */
-
- void drawMaze(sf::RenderWindow& window, const Maze& maze, float topOffset)
+ void drawMazeArea(sf::RenderWindow& window, const Maze& maze, float left, float top, float areaWidth, float areaHeight)
  {
-    // grab the window's size in pixels
-    sf::Vector2u windowSize = window.getSize(); // gives us mathematical vector object holding x and y
-    float windowWidth = static_cast<float> (windowSize.x);
-    float windowHeight = static_cast<float> (windowSize.y);
-    // make them floats for max accuracy
+    MAZE_TRACE_ZONE("drawMaze");
 
     //calculate cell width and height
-    // to keep cells proportional, divide width of window by width of maze
-    float cellWidth = windowWidth / maze.getWidth();
-    // subtract top bar offset from window height then divide by maze height
-    float cellHeight = (windowHeight - topOffset) / maze.getHeight();
+    // to keep cells proportional, divide width of area by width of maze
+    float cellWidth = areaWidth / maze.getWidth();
+    float cellHeight = areaHeight / maze.getHeight();
 
     sf::RectangleShape cellObj(sf::Vector2f(cellWidth, cellHeight));
     // SFML rectangle shape object with given height and width
@@ -128,40 +280,164 @@ void handleArguments(int argc, char* argv[], int& width, int&height){
     	for (int col = 0; col < maze.getWidth(); col++)
         {
             //set position
-            cellObj.setPosition( col * cellWidth, topOffset + (row * cellHeight));
+            cellObj.setPosition(left + col * cellWidth, top + (row * cellHeight));
 
             // get cell type
             CellType cellType = maze.getCell(row, col).type;
 
-            switch (cellType) //assign color baed on type of cell
-            {
-                case CellType::Wall:
-                    cellObj.setFillColor(sf::Color(50, 50, 50)); //dark gray
-                    break;
-                case CellType::Path:
-                    cellObj.setFillColor(sf::Color(255, 255, 255)); //whote
-                    break;
-                case CellType::Start:
-                    cellObj.setFillColor(sf::Color(0, 200, 0)); //green
-                    break;
-                case CellType::End:
-                    cellObj.setFillColor(sf::Color(200, 0, 0)); //red
-                    break;
-                case CellType::Visited:
-                    cellObj.setFillColor(sf::Color(173, 216, 230)); //light blue
-                    break;
-                case CellType::Solution:
-                    cellObj.setFillColor(sf::Color(255, 255, 0)); //yellow
-                    break;
-                default: //default tp path
-                    cellObj.setFillColor(sf::Color(255, 255, 255));
-                    break;
-            }
+            // assign color based on type of cell, same lookup table the
+            // headless exporter uses (wall gray, path white, start green,
+            // end red, visited light blue, solution yellow)
+            const RGB& color = CELL_PALETTE[static_cast<int>(cellType)];
+            cellObj.setFillColor(sf::Color(color.r, color.g, color.b));
             window.draw(cellObj);
         }
     }
  }
 
+/**
+ * @brief Draws the maze grid to the screen based on current window size.
+ * @param window The SFML window object we draw on
+ * @param maze The maze data structure
+ * @param topOffset height of black UI bar at the top
+ */
+ void drawMaze(sf::RenderWindow& window, const Maze& maze, float topOffset)
+ {
+    // grab the window's size in pixels
+    sf::Vector2u windowSize = window.getSize(); // gives us mathematical vector object holding x and y
+    float windowWidth = static_cast<float> (windowSize.x);
+    float windowHeight = static_cast<float> (windowSize.y);
+    // make them floats for max accuracy
+
+    // everything below the top bar
+    drawMazeArea(window, maze, 0.0f, topOffset, windowWidth, windowHeight - topOffset);
+ }
+
+/**
+ * @brief Runs one race pane's solver (on the pane's worker thread).
+ * @param pane pane to report into
+ * @param work private copy of the maze, solved in place
+ * @param delay animation delay per discovered cell
+ * @param cancel set by the UI to stop the race
+ */
+void runRacePane(RacePane& pane, Maze work, sf::Time delay, const std::atomic<bool>& cancel)
+{
+    RaceObserver observer{pane, cancel, delay, sf::Clock(), sf::Time()};
+    std::vector<Position> path;
+    try
+    {
+        int nodes = 0;
+        if (pane.name == "BFS")
+        {
+            path = solveBFS(work, observer, nodes);
+        }
+        else if (pane.name == "DEAD-END FILL")
+        {
+            path = solveDeadEndFill(work, observer, nodes, 1);
+        }
+        else if (pane.name == "TREMAUX")
+        {
+            // no discovery hook: the pane fills in when it finishes
+            RaceGrid grid{work, cancel};
+            StreamingSolveStats stats = solveTremaux(grid, [&](const Position& p) { path.push_back(p); });
+            nodes = static_cast<int>(stats.steps);
+        }
+        else
+        {
+            // includes building the cluster index, as it would on a fresh maze
+            HierarchicalPathfinder hierarchy(work, 32, &cancel);
+            path = solveHierarchical(work, hierarchy, nodes);
+            if (cancel)
+            {
+                throw RaceCancelled(); // the index stopped early, path is empty
+            }
+        }
+        pane.nodes = nodes;
+        pane.micros = (observer.clock.getElapsedTime() - observer.slept).asMicroseconds();
+    }
+    catch (const RaceCancelled&)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(pane.mutex);
+    for (const Position& pos : path)
+    {
+        CellType type = pane.view.getCell(pos.row, pos.col).type;
+        if (type != CellType::Start && type != CellType::End)
+        {
+            pane.view.setCellType(pos.row, pos.col, CellType::Solution);
+        }
+    }
+    pane.pathLength = static_cast<int>(path.size());
+    pane.done = true;
+}
+
+/**
+ * @brief Draws the race panes (2 or 3 side by side, 4 as a 2x2 grid)
+ * with each pane's live stats in its corner.
+ * @param window The SFML window object we draw on
+ * @param panes running or finished race panes
+ * @param topOffset height of black UI bar at the top
+ * @param label text object reused for every pane's stats
+ * @param validFont false if the font failed to load (stats are skipped)
+ */
+void drawRace(sf::RenderWindow& window, std::vector<std::unique_ptr<RacePane>>& panes, float topOffset, sf::Text& label, bool validFont)
+{
+    sf::Vector2u windowSize = window.getSize();
+    int columns = panes.size() == 4 ? 2 : static_cast<int>(panes.size());
+    int rows = panes.size() == 4 ? 2 : 1;
+    float paneWidth = static_cast<float>(windowSize.x) / columns;
+    float paneHeight = (static_cast<float>(windowSize.y) - topOffset) / rows;
+    const float gap = 2.0f; // dark border between panes
+
+    sf::RectangleShape labelBack;
+    labelBack.setFillColor(sf::Color(0, 0, 0, 180));
+
+    for (std::size_t i = 0; i < panes.size(); ++i)
+    {
+        RacePane& pane = *panes[i];
+        float left = (i % columns) * paneWidth;
+        float top = topOffset + (i / columns) * paneHeight;
+        {
+            std::lock_guard<std::mutex> lock(pane.mutex);
+            drawMazeArea(window, pane.view, left + gap, top + gap, paneWidth - 2 * gap, paneHeight - 2 * gap);
+        }
+
+        if (validFont)
+        {
+            std::ostringstream text;
+            text << pane.name << "\nNODES: " << pane.nodes.load()
+                 << "\nTIME: " << std::fixed << std::setprecision(2) << pane.micros.load() / 1000.0 << "MS"
+                 << "\nPATH: " << (pane.done ? std::to_string(pane.pathLength.load()) : "...");
+            label.setString(text.str());
+            label.setPosition(left + 8, top + 8);
+            sf::FloatRect bounds = label.getGlobalBounds();
+            labelBack.setPosition(bounds.left - 4, bounds.top - 4);
+            labelBack.setSize(sf::Vector2f(bounds.width + 8, bounds.height + 8));
+            window.draw(labelBack);
+            window.draw(label);
+        }
+    }
+}
+
+
+/**
+ * @brief Marks a cached path as Solution, as the solvers do, without searching.
+ * @param maze maze the path belongs to (visualization already reset)
+ * @param path cached path, decoded step by step
+ */
+void markSolution(Maze& maze, const CompactPath& path)
+{
+    for (const Position& pos : path)
+    {
+        CellType type = maze.getCell(pos.row, pos.col).type;
+        if (type != CellType::Start && type != CellType::End)
+        {
+            maze.setCellType(pos.row, pos.col, CellType::Solution);
+        }
+    }
+}
 
 // handler for R, G, Escape
  /**
@@ -176,8 +452,9 @@ void handleArguments(int argc, char* argv[], int& width, int&height){
  * @param status reference to string holding status
  * @param pathLength reference to int holding path length
  * @param nodes reference to int holding nodes explored
+ * @param requestGenerate starts (or cancels) background generation
  */
-void keyBoardHandler(sf::Event& event, sf::RenderWindow& window, Maze& maze, sf::Text& sizeAlgo, sf::Text& stats, sf::Text& controls, const float& delay, std::string& status, int& pathLength, int& nodes)
+void keyBoardHandler(sf::Event& event, sf::RenderWindow& window, Maze& maze, sf::Text& sizeAlgo, sf::Text& stats, sf::Text& controls, const float& delay, std::string& status, int& pathLength, int& nodes, const std::function<void()>& requestGenerate)
 {
     //if the event is a keypress
     if (event.type == sf::Event::KeyPressed)
@@ -202,12 +479,8 @@ void keyBoardHandler(sf::Event& event, sf::RenderWindow& window, Maze& maze, sf:
         if (event.key.code == sf::Keyboard::G)
         {
             //13. Press 'G' to generate a new random maze
-            maze.generate();
-            maze.resetVisualization(); //clear colors on new maze
-            pathLength = - 1;
-            nodes = 0; //reset
-            status = "New Maze!";
-            //updateStatus(sizeAlgo, stats, controls, maze, status, pathLength, nodes, delay);
+            // runs on a background thread; the new maze is swapped in when done
+            requestGenerate();
         }
     }
 }
@@ -220,15 +493,44 @@ int main(int argc, char* argv[]) {
     int pathLength = -1; //holds path length
     bool isSolving = false; //flag denoting solve state
     std::string status = "READY"; //holds status string
+    std::string solverName = "BFS"; //solver shown in the HUD
     int nodes = 0; // nodes explored
+    SolverWorkspace workspace; // reused by every S/D solve
+    PathCache pathCache; // S/D results while the maze is unchanged
+    bool diagonalMoves = false; // X: S searches 8-connected
 
     // parse inputs and setup maze
     int width, height;
     handleArguments(argc, argv, width, height);
 
+    // optional hardware counter line in the HUD (toggled with P)
+    bool showPerf = false;
+    auto perfLine = [&]() -> std::string {
+        if (!showPerf)
+        {
+            return "";
+        }
+#ifdef MAZE_ENABLE_PERF_COUNTERS
+        // whichever top-level phase ran last: a generation, S, D, ...
+        std::string line = PerfProfiler::instance().formatHudLine(PerfProfiler::instance().getLastPhase());
+        return line.empty() ? "PERF: GENERATE OR SOLVE TO MEASURE" : line;
+#else
+        return "PERF: NOT BUILT IN";
+#endif
+    };
+
     // initialize and generate maze with our set width and height
     Maze maze (width, height);
     maze.generate();
+
+    // background generation: builds into backMaze, swapped in when complete
+    Maze backMaze (width, height);
+    std::thread genThread;
+    std::atomic<bool> genCancel(false);
+    std::atomic<bool> genDone(false);
+    std::atomic<bool> genSucceeded(false);
+    std::atomic<int> genProgress(0);
+    bool generating = false;
     float delayTime = 0.05f; //default delay 50 ms
 
     // initialize window and font
@@ -265,16 +567,43 @@ int main(int argc, char* argv[]) {
     }
 
 
+    // split-screen solver race (V cycles 2, 3, 4 panes, then off)
+    std::vector<std::unique_ptr<RacePane>> racePanes;
+    std::atomic<bool> raceCancel(false);
+    bool raceRunning = false; // some pane has not finished yet
+    sf::Text raceLabel;
+    if (validFont)
+    {
+      raceLabel.setFont(font);
+      raceLabel.setCharacterSize(10);
+      raceLabel.setFillColor(sf::Color::White);
+    }
+
     //initial status
-    updateStatus(sizeAlgo, stats, controls, maze, status, pathLength, nodes, delayTime);
+    HudValues hudShown;
+    updateStatus(sizeAlgo, stats, controls, maze, solverName, status, pathLength, nodes, delayTime, perfLine(), hudShown);
+
+    // render-on-change: only draw when something on screen changed.
+    // set by input, resize, generate and solver progress.
+    bool dirty = true;
+    bool hudLayoutDirty = true; // text columns need re-positioning
+    const sf::Time minFrameTime = sf::microseconds(1000000 / 60); // cap animation at 60 fps
+    sf::Clock frameClock;
 
+    // true while a speed key is held (the delay keeps changing, so keep animating)
+    auto speedKeyHeld = []() {
+        return sf::Keyboard::isKeyPressed(sf::Keyboard::Add) || sf::Keyboard::isKeyPressed(sf::Keyboard::Equal) ||
+               sf::Keyboard::isKeyPressed(sf::Keyboard::Subtract) || sf::Keyboard::isKeyPressed(sf::Keyboard::Dash);
+    };
 
     //lambda function/code snippet that handles visuals dynamically
     auto renderer = [&](bool wait) {
-        window.clear(); //clear previous frame
+        MAZE_TRACE_ZONE("renderer");
 
-        //update UI every frame to reflect real time updating of speed and node count
-        updateStatus(sizeAlgo, stats, controls, maze, status, pathLength, nodes, delayTime);
+        if (wait)
+        {
+            dirty = true; // called by the solver: a cell was just discovered
+        }
 
         // continous polling for adjusting delay time (allows holding)
         if (sf::Keyboard::isKeyPressed(sf::Keyboard::Add) || sf::Keyboard::isKeyPressed(sf::Keyboard::Equal))
@@ -283,6 +612,7 @@ int main(int argc, char* argv[]) {
             if (delayTime > 0.001f)
             {
             	delayTime -= 0.001f; //decrease delay, speed up
+                dirty = true;
             }
         }
         if (sf::Keyboard::isKeyPressed(sf::Keyboard::Subtract) || sf::Keyboard::isKeyPressed(sf::Keyboard::Dash))
@@ -291,58 +621,94 @@ int main(int argc, char* argv[]) {
             if (delayTime < 1.0f)
             {
             	delayTime += 0.001f; //increase delay, slow down
+                dirty = true;
             }
         }
 
-        // check for reset while bfs is running
-        // this allows the user to reset or generate mid solve.
-        if (isSolving)
+        // frame limiter: while solving, skip frames that come too soon
+        // (the solver keeps running); when idle, wait out the rest of the frame
+        sf::Time sinceFrame = frameClock.getElapsedTime();
+        bool drawNow = dirty;
+        if (drawNow && sinceFrame < minFrameTime)
         {
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::R) || sf::Keyboard::isKeyPressed(sf::Keyboard::G)) 
+            if (wait)
+            {
+                drawNow = false;
+            }
+            else
             {
-                throw ResetException();
+                sf::sleep(minFrameTime - sinceFrame);
             }
         }
 
+        if (drawNow)
+        {
+            frameClock.restart();
+            dirty = false;
+            window.clear(); //clear previous frame
+
+            //update UI to reflect real time updating of speed and node count
+            //(text only changes, and is re-laid out, when its values do)
+            if (updateStatus(sizeAlgo, stats, controls, maze, solverName, status, pathLength, nodes, delayTime, perfLine(), hudShown))
+            {
+                hudLayoutDirty = true;
+            }
 
+            //calculate dynamic height using current window size
+            sf::Vector2u winSize = window.getSize();
+            float winWidth = static_cast<float>(winSize.x);
+            float winHeight = static_cast<float>(winSize.y);
+            float barHeight = winHeight * barRatio;
+            
 
-        //calculate dynamic height using current window size
-        sf::Vector2u winSize = window.getSize();
-        float winWidth = static_cast<float>(winSize.x);
-        float winHeight = static_cast<float>(winSize.y);
-        float barHeight = winHeight * barRatio;
-        
+            // draw maze (or the race panes) and top bar
+            if (racePanes.empty())
+            {
+                drawMaze(window, maze, barHeight);
+            }
+            else
+            {
+                drawRace(window, racePanes, barHeight, raceLabel, validFont);
+            }
 
-        // draw maze and top bar
-        drawMaze(window, maze, barHeight);
-        topBar.setSize(sf::Vector2f(winWidth, barHeight));
-        window.draw(topBar);
+            if (hudLayoutDirty)
+            {
+                hudLayoutDirty = false;
+                topBar.setSize(sf::Vector2f(winWidth, barHeight));
 
-        if (validFont)
-        // waste of computational power if font doesnt load
-        {
-            //left col holds size and algo
-            sizeAlgo.setPosition(20, 10);
-            window.draw(sizeAlgo);
+                //left col holds size and algo
+                sizeAlgo.setPosition(20, 10);
 
-            //middle col holds stats
-            //calculate center
-            float statsXPos = (winWidth / 2.0f) - (stats.getGlobalBounds().width / 2.0f);
-            stats.setPosition(statsXPos, 10);
-            window.draw(stats);
+                //middle col holds stats
+                //calculate center
+                float statsXPos = (winWidth / 2.0f) - (stats.getGlobalBounds().width / 2.0f);
+                stats.setPosition(statsXPos, 10);
 
-            //right col holds controls
-            float controlXPos = winWidth - controls.getGlobalBounds().width - 20;
-            controls.setPosition(controlXPos, 10);
-            window.draw(controls);
-        }
+                //right col holds controls
+                float controlXPos = winWidth - controls.getGlobalBounds().width - 20;
+                controls.setPosition(controlXPos, 10);
+            }
+            window.draw(topBar);
+
+            if (validFont)
+            // waste of computational power if font doesnt load
+            {
+                window.draw(sizeAlgo);
+                window.draw(stats);
+                window.draw(controls);
+            }
 
-        window.display();
+            {
+                MAZE_TRACE_ZONE("window.display");
+                window.display();
+            }
+        }
         
 
         if (wait) {
             // this secondary polling keeps the window responsive
             // handles exit and resize logic during BFS
+            MAZE_TRACE_ZONE("pollEvents (solving)");
             sf::Event e;
             while (window.pollEvent(e))
             {
@@ -352,6 +718,14 @@ int main(int argc, char* argv[]) {
                     //allow user to exit even during BFS
                     window.close();
                 }
+                // check for reset while bfs is running
+                // this allows the user to reset or generate mid solve.
+                // (uses the key event itself, so it is consumed exactly once)
+                if (isSolving && e.type == sf::Event::KeyPressed &&
+                    (e.key.code == sf::Keyboard::R || e.key.code == sf::Keyboard::G))
+                {
+                    throw ResetException(e.key.code);
+                }
                 if (e.type == sf::Event::Resized)
                 {
                     // if we resize the window, update view
@@ -359,6 +733,7 @@ int main(int argc, char* argv[]) {
                     // sf::FloatRect(0,0,width,height) -> defines 2D rectangle with new dimensions of window
                     // sf::View(...) -> update the view with new window dimensions
                     window.setView(sf::View(sf::FloatRect(0, 0, (float)e.size.width, (float)e.size.height)));
+                    hudLayoutDirty = true;
                 }
             }
             // pause execution so we can actually watch the solving
@@ -367,14 +742,122 @@ int main(int argc, char* argv[]) {
     };
 
 
-    // main input loop
+    // G: start a background generation, or cancel the one in flight
+    std::function<void()> requestGenerate = [&]() {
+        if (generating)
+        {
+            // the worker polls genCancel every few thousand cells, so this join is short
+            genCancel = true;
+            genThread.join();
+            generating = false;
+            status = "GENERATION CANCELLED";
+            return;
+        }
+        genCancel = false;
+        genDone = false;
+        genProgress = 0;
+        generating = true;
+        status = "GENERATING 0%";
+        genThread = std::thread([&]() {
+            genSucceeded = backMaze.generate(genCancel, genProgress);
+            genDone = true;
+        });
+    };
 
-    while (window.isOpen())
-    {
-        sf::Event event;
+    // called every loop iteration: show progress, swap in a finished maze
+    auto pollGeneration = [&]() {
+        if (!generating)
+        {
+            return;
+        }
+        if (!genDone)
+        {
+            std::string progressStatus = "GENERATING " + std::to_string(genProgress.load()) + "%";
+            if (progressStatus != status)
+            {
+                status = progressStatus;
+                dirty = true;
+            }
+            return;
+        }
+        genThread.join();
+        generating = false;
+        if (genSucceeded)
+        {
+            std::swap(maze, backMaze); // the UI thread owns both; no partial maze is ever drawn
+            maze.resetVisualization(); //clear colors on new maze
+            pathLength = -1;
+            nodes = 0; //reset
+            status = "New Maze!";
+        }
+        dirty = true;
+    };
+
+    // stops the race threads and returns to the single maze view
+    auto stopRace = [&]() {
+        raceCancel = true;
+        for (auto& pane : racePanes)
+        {
+            pane->worker.join(); // every solver checks raceCancel at least once per step
+        }
+        if (!racePanes.empty())
+        {
+            solverName = "BFS";
+        }
+        racePanes.clear();
+        raceCancel = false;
+        raceRunning = false;
+        dirty = true;
+    };
+
+    // starts count solvers on identical copies of the current maze
+    auto startRace = [&](int count) {
+        stopRace();
+        maze.resetVisualization();
+        sf::Time delay = sf::milliseconds(static_cast<int>(delayTime * 1000));
+        for (int i = 0; i < count; ++i)
+        {
+            racePanes.emplace_back(new RacePane(RACE_SOLVERS[i], maze));
+        }
+        // start threads only once the vector no longer moves
+        for (auto& pane : racePanes)
+        {
+            pane->worker = std::thread(runRacePane, std::ref(*pane), maze, delay, std::cref(raceCancel));
+        }
+        solverName = "RACE";
+        status = "RACING...";
+        raceRunning = true;
+    };
 
-        while (window.pollEvent(event))
+    // live race stats: keep redrawing until every pane has finished
+    auto pollRace = [&]() {
+        if (!raceRunning)
+        {
+            return;
+        }
+        dirty = true;
+        bool allDone = true;
+        for (auto& pane : racePanes)
+        {
+            allDone = allDone && pane->done;
+        }
+        if (allDone)
         {
+            raceRunning = false;
+            status = "RACE DONE!";
+        }
+    };
+
+    // handles one event from the main loop
+    auto handleEvent = [&](sf::Event& event) {
+            MAZE_TRACE_ZONE("handleEvent");
+
+            // anything the user does may change what is on screen
+            if (event.type == sf::Event::KeyPressed || event.type == sf::Event::Resized || event.type == sf::Event::GainedFocus)
+            {
+                dirty = true;
+            }
+
             if (event.type == sf::Event::Closed)
 			{
 				//18. Handle window close event properly
@@ -387,14 +870,70 @@ int main(int argc, char* argv[]) {
 				// sf::FloatRect(0,0,width,height) -> defines 2D rectangle with new dimensions of window
 				// sf::View(...) -> update the view with new window dimensions
 				window.setView(sf::View(sf::FloatRect(0, 0, (float)event.size.width, (float)event.size.height)));
+				hudLayoutDirty = true;
+			}
+
+			// M cycles the generator used by the next G
+			// (both buffers, the back one is what G actually generates into)
+			if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::M && !generating)
+			{
+				GeneratorAlgorithm next = static_cast<GeneratorAlgorithm>((static_cast<int>(maze.getAlgorithm()) + 1) % 3);
+				maze.setAlgorithm(next);
+				backMaze.setAlgorithm(next);
+			}
+
+			// X toggles diagonal moves for the next S
+			if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::X && !isSolving)
+			{
+				diagonalMoves = !diagonalMoves;
+				solverName = diagonalMoves ? "BFS 8-WAY" : "BFS";
+			}
+
+			// P toggles hardware counter measurement and its HUD line
+			if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::P)
+			{
+				showPerf = !showPerf;
+				PerfProfiler::instance().setEnabled(showPerf);
+			}
+
+#ifdef MAZE_ENABLE_TRACING
+			// T dumps the trace rings for chrome://tracing or Perfetto
+			if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::T)
+			{
+				bool dumped = Tracer::instance().dumpChromeJson("maze_trace.json");
+				status = dumped ? "TRACE SAVED" : "TRACE FAILED";
+			}
+#endif
+
+			// V cycles the race view: 2, 3, 4 panes, then back to one maze.
+			// any other maze action ends the race first.
+			if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::V && !generating)
+			{
+				if (racePanes.size() >= 4)
+				{
+					stopRace();
+					status = "READY";
+				}
+				else
+				{
+					startRace(racePanes.empty() ? 2 : static_cast<int>(racePanes.size()) + 1);
+				}
+			}
+			if (event.type == sf::Event::KeyPressed && !racePanes.empty() &&
+				(event.key.code == sf::Keyboard::R || event.key.code == sf::Keyboard::G ||
+				 event.key.code == sf::Keyboard::S || event.key.code == sf::Keyboard::D))
+			{
+				stopRace();
 			}
 
 			// custom handler for R, G, escape
-			keyBoardHandler(event, window, maze, sizeAlgo, stats, controls, delayTime, status, pathLength, nodes);
+			keyBoardHandler(event, window, maze, sizeAlgo, stats, controls, delayTime, status, pathLength, nodes, requestGenerate);
 
-			// S logic
-			if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::S)
+			// S (BFS) / D (dead-end fill) logic
+			if (event.type == sf::Event::KeyPressed &&
+				(event.key.code == sf::Keyboard::S || event.key.code == sf::Keyboard::D))
 			{
+				MAZE_TRACE_ZONE("solve");
 				try
 				{
 					isSolving = true;
@@ -402,12 +941,43 @@ int main(int argc, char* argv[]) {
 					status = "SOLVING...";
 					maze.resetVisualization();
 
-					auto path = solveBFS(maze, renderer, delayTime, nodes);
-					isSolving = false;
-					if (!path.empty())
+					bool deadEnd = event.key.code == sf::Keyboard::D;
+					solverName = deadEnd ? "DEAD-END FILL" : (diagonalMoves ? "BFS 8-WAY" : "BFS");
+
+					// same maze, same query: show the stored result instead of searching
+					// (8-way solves are neither looked up nor stored: their paths do not
+					// fit the 2-bit encoding, and one without diagonal steps would
+					// otherwise land under the 4-way BFS key with 8-way node counts)
+					Position start = {maze.getStart().first, maze.getStart().second};
+					Position end = {maze.getEnd().first, maze.getEnd().second};
+					CachedSolver cacheKey = deadEnd ? CachedSolver::DeadEndFill : CachedSolver::BFS;
+					const bool cacheable = deadEnd || !diagonalMoves;
+					const CachedPath* cached = cacheable ? pathCache.find(maze, start, end, cacheKey) : nullptr;
+					if (cached)
+					{
+						markSolution(maze, cached->path);
+						isSolving = false;
+						nodes = cached->nodes;
+						if (!cached->path.empty())
+						{
+							status = "SOLVED! (CACHED)";
+							pathLength = static_cast<int>(cached->path.size());
+						}
+					}
+					else
 					{
-						status = "SOLVED!"; //update status string
-						pathLength = static_cast<int>(path.size()); //update path length
+						const std::vector<Position>& path = deadEnd ? solveDeadEndFill(maze, renderer, delayTime, nodes, workspace)
+						                                            : solveBFS(maze, renderer, delayTime, nodes, workspace, diagonalMoves);
+						isSolving = false;
+						if (cacheable)
+						{
+							pathCache.store(maze, start, end, cacheKey, path, nodes);
+						}
+						if (!path.empty())
+						{
+							status = "SOLVED!"; //update status string
+							pathLength = static_cast<int>(path.size()); //update path length
+						}
 					}
 				}
 				catch (const ResetException& e)
@@ -420,23 +990,72 @@ int main(int argc, char* argv[]) {
 					// manually handle reset logic so user doesnt have to click key twice for response
 					// without this, first click of R/G pauses solving, second click works
 
-					if (sf::Keyboard::isKeyPressed(sf::Keyboard::R))
+					if (e.key == sf::Keyboard::R)
 					{
 						status = "Maze Reset!";
 					}
-					else if (sf::Keyboard::isKeyPressed(sf::Keyboard::G))
+					else
 					{
-						maze.generate();
-						status = "New Maze!";
+						requestGenerate();
 					}
 				}
+				dirty = true; // solve finished or was interrupted
 			}
+    };
+
+
+    // main input loop
+
+    while (window.isOpen())
+    {
+        sf::Event event;
+
+        MAZE_TRACE_ZONE("frame");
+
+        pollGeneration();
+        pollRace();
+
+        // nothing changed and no key held: block until the OS has an event
+        // instead of spinning a core redrawing an identical frame
+        // (not while generating or racing, their progress has to keep updating;
+        // finished race panes are static and may wait like the maze view)
+        if (!dirty && !speedKeyHeld() && !generating && !raceRunning)
+        {
+            MAZE_TRACE_ZONE("waitEvent");
+            if (window.waitEvent(event))
+            {
+                handleEvent(event);
+            }
+        }
+
+        while (window.isOpen() && window.pollEvent(event))
+        {
+            handleEvent(event);
         }
 
         // screen refreshing
         // call renderer(false) for no wait/sleep when just idle
+        // (draws only if something is dirty, capped at 60 fps)
         renderer(false);
+
+        if (generating && !dirty)
+        {
+            sf::sleep(minFrameTime); // nothing new to show yet, check progress again shortly
+        }
     }
 
+    // don't leave a worker running past the maze it writes to
+    if (generating)
+    {
+        genCancel = true;
+        genThread.join();
+    }
+    stopRace();
+
+#ifdef MAZE_ENABLE_TRACING
+    // keep whatever is still in the rings when the window closes
+    Tracer::instance().dumpChromeJson("maze_trace.json");
+#endif
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,105 @@
+/**
+ * @file server_main.cpp
+ * @brief MazeServer daemon entry point
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * Usage:
+ *   MazeServer [options]
+ *
+ * Options:
+ *   --socket PATH  Unix socket to listen on (default /tmp/mazed.sock)
+ *   --cache N      resident mazes kept (default 16)
+ *   --threads N    batch worker threads (default: all cores)
+ *   --max N        largest maze edge accepted (default 4001, at most
+ *                  MazeServer::MAX_DIMENSION so cell indices cannot overflow)
+ *
+ * Runs until SIGINT/SIGTERM, then prints its counters.
+ */
+
+#include "MazeServer.h"
+#include <csignal>
+#include <iostream>
+#include <string>
+
+namespace
+{
+    std::atomic<bool> stopRequested(false);
+
+    void onSignal(int)
+    {
+        stopRequested = true;
+    }
+}
+
+/**
+ * @brief Prints usage information to stderr.
+ */
+void printUsage()
+{
+    std::cerr << "Usage: MazeServer [--socket PATH] [--cache N] [--threads N] [--max N]" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    MazeServerOptions options;
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            if (arg == "--socket" && i + 1 < argc)
+            {
+                options.socketPath = argv[++i];
+            }
+            else if (arg == "--cache" && i + 1 < argc)
+            {
+                options.cacheEntries = static_cast<std::size_t>(std::stoul(argv[++i]));
+            }
+            else if (arg == "--threads" && i + 1 < argc)
+            {
+                options.threads = static_cast<unsigned>(std::stoul(argv[++i]));
+            }
+            else if (arg == "--max" && i + 1 < argc)
+            {
+                options.maxDimension = std::stoi(argv[++i]);
+                if (options.maxDimension < 1 || options.maxDimension > MazeServer::MAX_DIMENSION)
+                {
+                    std::cerr << "--max must be between 1 and " << MazeServer::MAX_DIMENSION << std::endl;
+                    return 1;
+                }
+            }
+            else
+            {
+                printUsage();
+                return 1;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        printUsage();
+        return 1;
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+#ifdef SIGPIPE
+    std::signal(SIGPIPE, SIG_IGN); // a client vanishing mid-reply is not fatal
+#endif
+
+    MazeServer server(options);
+    if (!server.start())
+    {
+        std::cerr << "Cannot listen on " << options.socketPath << std::endl;
+        return 1;
+    }
+    std::cout << "listening on " << options.socketPath << std::endl;
+
+    server.run(stopRequested);
+
+    MazeServerStats stats = server.getStats();
+    std::cout << "requests " << stats.requests << ", batches " << stats.batches
+              << " (largest " << stats.largestBatch << "), generated " << stats.generated
+              << ", cache hits " << stats.cacheHits << ", evictions " << stats.evictions << std::endl;
+    return 0;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file stream_main.cpp
+ * @brief Solve an exported maze image in place with a bounded-memory solver
+ * @course ECE 4122/6122 - Homework 1
+ *
+ * Usage:
+ *   MazeStreamSolve <maze.ppm> [options]
+ *
+ * The image must come from MazeExport with --scale 1 and a .ppm name.
+ * It is memory-mapped, not loaded, so mazes larger than RAM can be solved.
+ *
+ * Options:
+ *   --solver NAME  tremaux (default) or wall
+ *   --path FILE    stream the route to FILE as "row col" lines
+ */
+
+#include "MappedMazeImage.h"
+#include "StreamingSolvers.h"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+/**
+ * @brief Prints usage information to stderr.
+ */
+void printUsage()
+{
+    std::cerr << "Usage: MazeStreamSolve <maze.ppm> [--solver tremaux|wall] [--path FILE]" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        printUsage();
+        return 1;
+    }
+
+    std::string input = argv[1];
+    std::string solver = "tremaux";
+    std::string pathFile;
+    for (int i = 2; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--solver" && i + 1 < argc)
+        {
+            solver = argv[++i];
+        }
+        else if (arg == "--path" && i + 1 < argc)
+        {
+            pathFile = argv[++i];
+        }
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+    if (solver != "tremaux" && solver != "wall")
+    {
+        std::cerr << "Unknown solver: " << solver << std::endl;
+        return 1;
+    }
+
+    MappedMazeImage maze;
+    if (!maze.open(input))
+    {
+        std::cerr << "Cannot map " << input << " (expected a binary PPM from MazeExport --scale 1)" << std::endl;
+        return 1;
+    }
+
+    std::ofstream out;
+    if (!pathFile.empty())
+    {
+        out.open(pathFile);
+        if (!out)
+        {
+            std::cerr << "Cannot write " << pathFile << std::endl;
+            return 1;
+        }
+    }
+    auto sink = [&](const Position& p) {
+        if (out.is_open())
+        {
+            out << p.row << ' ' << p.col << '\n';
+        }
+    };
+
+    auto t0 = std::chrono::steady_clock::now();
+    StreamingSolveStats stats = solver == "wall" ? solveWallFollower(maze, sink) : solveTremaux(maze, sink);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::cout << "maze " << maze.getWidth() << "x" << maze.getHeight() << " (" << maze.getMappedBytes() << " bytes mapped)"
+              << ", solver " << solver << std::endl;
+    std::cout << (stats.solved ? "solved" : "no path") << " in " << seconds << " s, "
+              << (solver == "wall" ? "walk " : "path ") << stats.pathLength << ", steps " << stats.steps << std::endl;
+    std::cout << "memory: " << stats.auxiliaryBytes << " bytes auxiliary" << std::endl;
+    std::cout << "access: " << stats.probes << " probes, " << stats.rowSwitches << " row switches ("
+              << (stats.probes ? 100.0 * (stats.probes - stats.rowSwitches) / stats.probes : 0.0) << "% same-row)" << std::endl;
+    return stats.solved ? 0 : 2;
+}